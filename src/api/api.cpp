@@ -3,6 +3,7 @@
 #include <migraphx/shape.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/onnx.hpp>
+#include <migraphx/program_buckets.hpp>
 #include <migraphx/tf.hpp>
 #include <migraphx/instruction_ref.hpp>
 #include <migraphx/register_target.hpp>
@@ -16,6 +17,7 @@
 #include <migraphx/convert_to_json.hpp>
 #include <algorithm>
 #include <cstdarg>
+#include <future>
 
 namespace migraphx {
 
@@ -207,6 +209,117 @@ bool equal(const T& x, const T& y)
 
 std::vector<argument> run(program& p, const parameter_map& params) { return p.eval(params); }
 
+std::vector<argument> run(program_buckets& p, const parameter_map& params)
+{
+    return p.eval(params);
+}
+
+struct run_options
+{
+    std::unordered_map<std::string, argument> outputs = {};
+    bool copy_outputs                                 = true;
+};
+
+void bind_output(run_options& options, const char* name, const argument& arg)
+{
+    options.outputs[name] = arg;
+}
+
+void set_copy_outputs(run_options& options, bool value) { options.copy_outputs = value; }
+
+static std::size_t get_output_index(const program& p, const std::string& name)
+{
+    auto prefix = p.get_main_module()->name() + ":#output_";
+    auto n      = p.get_output_shapes().size();
+    for(std::size_t i = 0; i < n; i++)
+    {
+        if(name == prefix + std::to_string(i))
+            return i;
+    }
+    MIGRAPHX_THROW(migraphx_status_bad_param, "Unknown output: " + name);
+}
+
+// The bound outputs are passed as parameters when the target writes its outputs to parameters,
+// otherwise the results are copied into them after the run
+std::vector<argument> run(program& p, parameter_map params, const run_options& options)
+{
+    auto param_shapes  = p.get_parameter_shapes();
+    auto output_shapes = p.get_output_shapes();
+    std::vector<std::pair<std::size_t, argument>> copies;
+    for(auto&& out : options.outputs)
+    {
+        auto s = out.second.get_shape();
+        if(param_shapes.count(out.first) > 0)
+        {
+            if(param_shapes.at(out.first) != s)
+                MIGRAPHX_THROW(migraphx_status_bad_param, "Wrong shape for output: " + out.first);
+            params[out.first] = out.second;
+            continue;
+        }
+        auto i = get_output_index(p, out.first);
+        if(output_shapes[i] != s)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Wrong shape for output: " + out.first);
+        if(not options.copy_outputs)
+            MIGRAPHX_THROW(migraphx_status_bad_param,
+                           "Output is not written in place and copies are disabled: " + out.first);
+        copies.emplace_back(i, out.second);
+    }
+    auto results = p.eval(params);
+    for(auto&& c : copies)
+    {
+        visit_all(c.second, results[c.first])([&](auto output, auto input) {
+            std::copy(input.begin(), input.end(), output.begin());
+        });
+        results[c.first] = c.second;
+    }
+    return results;
+}
+
+struct run_future
+{
+    std::shared_future<std::vector<argument>> result;
+
+    bool ready() const
+    {
+        return result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+    void wait() const { result.wait(); }
+    std::vector<argument> get() const { return result.get(); }
+};
+
+// The program must not be destroyed or run again until the run has finished. The callback is
+// called from the thread running the program, before the future is ready.
+run_future run_async(program& p,
+                     parameter_map params,
+                     const run_options& options,
+                     migraphx_run_callback callback,
+                     void* data)
+{
+    auto* pp = &p;
+    return {std::async(std::launch::async, [=] {
+        std::vector<argument> results;
+        std::exception_ptr error;
+        auto status = try_(
+            [&] {
+                try
+                {
+                    results = run(*pp, params, options);
+                }
+                catch(...)
+                {
+                    error = std::current_exception();
+                    throw;
+                }
+            },
+            false);
+        if(callback != nullptr)
+            callback(status, data);
+        if(error)
+            std::rethrow_exception(error);
+        return results;
+    })};
+}
+
 std::vector<shape> get_output_shapes(program& p) { return p.get_output_shapes(); }
 
 void print_program(const program& p) { std::cout << p << std::endl; }
@@ -452,6 +565,28 @@ struct migraphx_program
     migraphx::program object;
 };
 
+extern "C" struct migraphx_run_options;
+struct migraphx_run_options
+{
+    template <class... Ts>
+    migraphx_run_options(Ts&&... xs)
+        : object(std::forward<Ts>(xs)...) // NOLINT(readability-redundant-member-init)
+    {
+    }
+    migraphx::run_options object;
+};
+
+extern "C" struct migraphx_run_future;
+struct migraphx_run_future
+{
+    template <class... Ts>
+    migraphx_run_future(Ts&&... xs)
+        : object(std::forward<Ts>(xs)...) // NOLINT(readability-redundant-member-init)
+    {
+    }
+    migraphx::run_future object;
+};
+
 extern "C" struct migraphx_operation;
 struct migraphx_operation
 {
@@ -496,6 +631,17 @@ struct migraphx_compile_options
     migraphx::compile_options object;
 };
 
+extern "C" struct migraphx_program_buckets;
+struct migraphx_program_buckets
+{
+    template <class... Ts>
+    migraphx_program_buckets(Ts&&... xs)
+        : object(std::forward<Ts>(xs)...) // NOLINT(readability-redundant-member-init)
+    {
+    }
+    migraphx::program_buckets object;
+};
+
 extern "C" struct migraphx_tf_options;
 struct migraphx_tf_options
 {
@@ -1234,6 +1380,45 @@ extern "C" migraphx_status migraphx_program_run(migraphx_arguments_t* out,
     return api_error_result;
 }
 
+extern "C" migraphx_status
+migraphx_program_run_with_options(migraphx_arguments_t* out,
+                                  migraphx_program_t program,
+                                  migraphx_program_parameters_t params,
+                                  const_migraphx_run_options_t options)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(program == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter program: Null pointer");
+        if(params == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter params: Null pointer");
+        if(options == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter options: Null pointer");
+        *out = allocate<migraphx_arguments_t>(
+            migraphx::run((program->object), (params->object), (options->object)));
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_program_run_async(migraphx_run_future_t* out,
+                                                      migraphx_program_t program,
+                                                      migraphx_program_parameters_t params,
+                                                      const_migraphx_run_options_t options,
+                                                      migraphx_run_callback callback,
+                                                      void* data)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(program == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter program: Null pointer");
+        if(params == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter params: Null pointer");
+        if(options == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter options: Null pointer");
+        *out = allocate<migraphx_run_future_t>(migraphx::run_async(
+            (program->object), (params->object), (options->object), (callback), (data)));
+    });
+    return api_error_result;
+}
+
 extern "C" migraphx_status
 migraphx_program_equal(bool* out, const_migraphx_program_t program, const_migraphx_program_t x)
 {
@@ -1258,6 +1443,97 @@ migraphx_program_experimental_get_context(migraphx_context_t* out, const_migraph
     return api_error_result;
 }
 
+extern "C" migraphx_status migraphx_run_options_destroy(migraphx_run_options_t run_options)
+{
+    auto api_error_result = migraphx::try_([&] { destroy((run_options)); });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_run_options_assign_to(migraphx_run_options_t output,
+                                                          const_migraphx_run_options_t input)
+{
+    auto api_error_result = migraphx::try_([&] { *output = *input; });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_run_options_create(migraphx_run_options_t* run_options)
+{
+    auto api_error_result = migraphx::try_([&] {
+        *run_options = object_cast<migraphx_run_options_t>(allocate<migraphx::run_options>());
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_run_options_bind_output(migraphx_run_options_t run_options,
+                                                            const char* name,
+                                                            const_migraphx_argument_t argument)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(run_options == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter run_options: Null pointer");
+        if(argument == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter argument: Null pointer");
+        migraphx::bind_output((run_options->object), (name), (argument->object));
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status
+migraphx_run_options_set_copy_outputs(migraphx_run_options_t run_options, bool value)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(run_options == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter run_options: Null pointer");
+        migraphx::set_copy_outputs((run_options->object), (value));
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_run_future_destroy(migraphx_run_future_t run_future)
+{
+    auto api_error_result = migraphx::try_([&] { destroy((run_future)); });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_run_future_assign_to(migraphx_run_future_t output,
+                                                         const_migraphx_run_future_t input)
+{
+    auto api_error_result = migraphx::try_([&] { *output = *input; });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_run_future_ready(bool* out,
+                                                     const_migraphx_run_future_t run_future)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(run_future == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter run_future: Null pointer");
+        *out = (run_future->object).ready();
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_run_future_wait(const_migraphx_run_future_t run_future)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(run_future == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter run_future: Null pointer");
+        (run_future->object).wait();
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_run_future_get(migraphx_arguments_t* out,
+                                                   const_migraphx_run_future_t run_future)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(run_future == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter run_future: Null pointer");
+        *out = allocate<migraphx_arguments_t>((run_future->object).get());
+    });
+    return api_error_result;
+}
+
 extern "C" migraphx_status migraphx_operation_destroy(migraphx_operation_t operation)
 {
     auto api_error_result = migraphx::try_([&] { destroy((operation)); });
@@ -1489,6 +1765,122 @@ extern "C" migraphx_status migraphx_parse_onnx_buffer(migraphx_program_t* out,
     return api_error_result;
 }
 
+extern "C" migraphx_status
+migraphx_program_buckets_destroy(migraphx_program_buckets_t program_buckets)
+{
+    auto api_error_result = migraphx::try_([&] { destroy((program_buckets)); });
+    return api_error_result;
+}
+
+extern "C" migraphx_status
+migraphx_program_buckets_assign_to(migraphx_program_buckets_t output,
+                                   const_migraphx_program_buckets_t input)
+{
+    auto api_error_result = migraphx::try_([&] { *output = *input; });
+    return api_error_result;
+}
+
+extern "C" migraphx_status
+migraphx_program_buckets_create(migraphx_program_buckets_t* program_buckets)
+{
+    auto api_error_result = migraphx::try_([&] {
+        *program_buckets =
+            object_cast<migraphx_program_buckets_t>(allocate<migraphx::program_buckets>());
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_program_buckets_insert(
+    migraphx_program_buckets_t program_buckets, size_t batch_size, const_migraphx_program_t program)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(program_buckets == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param,
+                           "Bad parameter program_buckets: Null pointer");
+        if(program == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter program: Null pointer");
+        (program_buckets->object).insert((batch_size), (program->object));
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status
+migraphx_program_buckets_size(size_t* out, const_migraphx_program_buckets_t program_buckets)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(program_buckets == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param,
+                           "Bad parameter program_buckets: Null pointer");
+        *out = (program_buckets->object).size();
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_program_buckets_select(
+    size_t* out, const_migraphx_program_buckets_t program_buckets, size_t batch_size)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(program_buckets == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param,
+                           "Bad parameter program_buckets: Null pointer");
+        *out = (program_buckets->object).select((batch_size));
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status
+migraphx_program_buckets_compile(migraphx_program_buckets_t program_buckets,
+                                 migraphx_target_t target,
+                                 migraphx_compile_options_t options)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(program_buckets == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param,
+                           "Bad parameter program_buckets: Null pointer");
+        if(target == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter target: Null pointer");
+        if(options == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter options: Null pointer");
+        (program_buckets->object).compile((target->object), (options->object));
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_program_buckets_run(migraphx_arguments_t* out,
+                                                        migraphx_program_buckets_t program_buckets,
+                                                        migraphx_program_parameters_t params)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(program_buckets == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param,
+                           "Bad parameter program_buckets: Null pointer");
+        if(params == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter params: Null pointer");
+        *out = allocate<migraphx_arguments_t>(
+            migraphx::run((program_buckets->object), (params->object)));
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_parse_onnx_buckets(migraphx_program_buckets_t* out,
+                                                       const char* name,
+                                                       size_t* batch_sizes,
+                                                       size_t batch_sizes_size,
+                                                       migraphx_onnx_options_t options)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(batch_sizes == nullptr and batch_sizes_size != 0)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter batch_sizes: Null pointer");
+        if(options == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter options: Null pointer");
+        *out = allocate<migraphx_program_buckets_t>(migraphx::parse_onnx_buckets(
+            (name),
+            (std::vector<size_t>(batch_sizes, batch_sizes + batch_sizes_size)),
+            (options->object)));
+    });
+    return api_error_result;
+}
+
 extern "C" migraphx_status migraphx_tf_options_destroy(migraphx_tf_options_t tf_options)
 {
     auto api_error_result = migraphx::try_([&] { destroy((tf_options)); });
@@ -43,6 +43,9 @@ typedef enum
 } migraphx_shape_datatype_t;
 #undef MIGRAPHX_SHAPE_GENERATE_ENUM_TYPES
 
+/// Called with the status of an asynchronous run when the run has finished
+typedef void (*migraphx_run_callback)(migraphx_status status, void* data);
+
 typedef struct migraphx_shape* migraphx_shape_t;
 typedef const struct migraphx_shape* const_migraphx_shape_t;
 
@@ -79,6 +82,12 @@ typedef const struct migraphx_module* const_migraphx_module_t;
 typedef struct migraphx_program* migraphx_program_t;
 typedef const struct migraphx_program* const_migraphx_program_t;
 
+typedef struct migraphx_run_options* migraphx_run_options_t;
+typedef const struct migraphx_run_options* const_migraphx_run_options_t;
+
+typedef struct migraphx_run_future* migraphx_run_future_t;
+typedef const struct migraphx_run_future* const_migraphx_run_future_t;
+
 typedef struct migraphx_operation* migraphx_operation_t;
 typedef const struct migraphx_operation* const_migraphx_operation_t;
 
@@ -91,6 +100,9 @@ typedef const struct migraphx_file_options* const_migraphx_file_options_t;
 typedef struct migraphx_compile_options* migraphx_compile_options_t;
 typedef const struct migraphx_compile_options* const_migraphx_compile_options_t;
 
+typedef struct migraphx_program_buckets* migraphx_program_buckets_t;
+typedef const struct migraphx_program_buckets* const_migraphx_program_buckets_t;
+
 typedef struct migraphx_tf_options* migraphx_tf_options_t;
 typedef const struct migraphx_tf_options* const_migraphx_tf_options_t;
 
@@ -304,12 +316,50 @@ migraphx_status migraphx_program_run(migraphx_arguments_t* out,
                                      migraphx_program_t program,
                                      migraphx_program_parameters_t params);
 
+migraphx_status migraphx_program_run_with_options(migraphx_arguments_t* out,
+                                                  migraphx_program_t program,
+                                                  migraphx_program_parameters_t params,
+                                                  const_migraphx_run_options_t options);
+
+migraphx_status migraphx_program_run_async(migraphx_run_future_t* out,
+                                           migraphx_program_t program,
+                                           migraphx_program_parameters_t params,
+                                           const_migraphx_run_options_t options,
+                                           migraphx_run_callback callback,
+                                           void* data);
+
 migraphx_status
 migraphx_program_equal(bool* out, const_migraphx_program_t program, const_migraphx_program_t x);
 
 migraphx_status migraphx_program_experimental_get_context(migraphx_context_t* out,
                                                           const_migraphx_program_t program);
 
+migraphx_status migraphx_run_options_destroy(migraphx_run_options_t run_options);
+
+migraphx_status migraphx_run_options_assign_to(migraphx_run_options_t output,
+                                               const_migraphx_run_options_t input);
+
+migraphx_status migraphx_run_options_create(migraphx_run_options_t* run_options);
+
+migraphx_status migraphx_run_options_bind_output(migraphx_run_options_t run_options,
+                                                 const char* name,
+                                                 const_migraphx_argument_t argument);
+
+migraphx_status migraphx_run_options_set_copy_outputs(migraphx_run_options_t run_options,
+                                                      bool value);
+
+migraphx_status migraphx_run_future_destroy(migraphx_run_future_t run_future);
+
+migraphx_status migraphx_run_future_assign_to(migraphx_run_future_t output,
+                                              const_migraphx_run_future_t input);
+
+migraphx_status migraphx_run_future_ready(bool* out, const_migraphx_run_future_t run_future);
+
+migraphx_status migraphx_run_future_wait(const_migraphx_run_future_t run_future);
+
+migraphx_status migraphx_run_future_get(migraphx_arguments_t* out,
+                                        const_migraphx_run_future_t run_future);
+
 migraphx_status migraphx_operation_destroy(migraphx_operation_t operation);
 
 migraphx_status migraphx_operation_assign_to(migraphx_operation_t output,
@@ -376,6 +426,38 @@ migraphx_status migraphx_parse_onnx_buffer(migraphx_program_t* out,
                                            size_t size,
                                            migraphx_onnx_options_t options);
 
+migraphx_status migraphx_program_buckets_destroy(migraphx_program_buckets_t program_buckets);
+
+migraphx_status migraphx_program_buckets_assign_to(migraphx_program_buckets_t output,
+                                                   const_migraphx_program_buckets_t input);
+
+migraphx_status migraphx_program_buckets_create(migraphx_program_buckets_t* program_buckets);
+
+migraphx_status migraphx_program_buckets_insert(migraphx_program_buckets_t program_buckets,
+                                                size_t batch_size,
+                                                const_migraphx_program_t program);
+
+migraphx_status migraphx_program_buckets_size(size_t* out,
+                                              const_migraphx_program_buckets_t program_buckets);
+
+migraphx_status migraphx_program_buckets_select(size_t* out,
+                                                const_migraphx_program_buckets_t program_buckets,
+                                                size_t batch_size);
+
+migraphx_status migraphx_program_buckets_compile(migraphx_program_buckets_t program_buckets,
+                                                 migraphx_target_t target,
+                                                 migraphx_compile_options_t options);
+
+migraphx_status migraphx_program_buckets_run(migraphx_arguments_t* out,
+                                             migraphx_program_buckets_t program_buckets,
+                                             migraphx_program_parameters_t params);
+
+migraphx_status migraphx_parse_onnx_buckets(migraphx_program_buckets_t* out,
+                                            const char* name,
+                                            size_t* batch_sizes,
+                                            size_t batch_sizes_size,
+                                            migraphx_onnx_options_t options);
+
 migraphx_status migraphx_tf_options_destroy(migraphx_tf_options_t tf_options);
 
 migraphx_status migraphx_tf_options_assign_to(migraphx_tf_options_t output,
@@ -6,6 +6,7 @@
 #include <migraphx/migraphx.h>
 #include <memory>
 #include <exception>
+#include <functional>
 #include <vector>
 #include <cassert>
 #include <iostream>
@@ -832,6 +833,53 @@ struct compile_options : MIGRAPHX_HANDLE_BASE(compile_options)
     }
 };
 
+/// Options for a single run of a program
+struct run_options : MIGRAPHX_HANDLE_BASE(run_options)
+{
+    run_options() { this->make_handle(&migraphx_run_options_create); }
+
+    MIGRAPHX_HANDLE_CONSTRUCTOR(run_options);
+
+    /// Write an output into the buffer of the argument instead of a buffer allocated by the
+    /// program. The outputs are named `main:#output_0`, `main:#output_1` and so on.
+    void bind_output(const char* name, const argument& arg) const
+    {
+        call(&migraphx_run_options_bind_output, this->get_handle_ptr(), name, arg.get_handle_ptr());
+    }
+
+    /// When the target cannot write an output directly into its bound buffer, the output is
+    /// copied into it after the run. Disabling the copies makes such a run fail instead.
+    void set_copy_outputs(bool value = true) const
+    {
+        call(&migraphx_run_options_set_copy_outputs, this->get_handle_ptr(), value);
+    }
+};
+
+/// The outputs of a program that is running asynchronously
+struct run_future : MIGRAPHX_HANDLE_BASE(run_future)
+{
+    MIGRAPHX_HANDLE_CONSTRUCTOR(run_future);
+
+    /// Return true when the run has finished, without waiting
+    bool ready() const
+    {
+        bool pout;
+        call(&migraphx_run_future_ready, &pout, this->get_handle_ptr());
+        return pout;
+    }
+
+    /// Wait until the run has finished
+    void wait() const { call(&migraphx_run_future_wait, this->get_handle_ptr()); }
+
+    /// Wait until the run has finished and return the outputs, or throw if the run failed
+    arguments get() const
+    {
+        migraphx_arguments_t pout;
+        call(&migraphx_run_future_get, &pout, this->get_handle_ptr());
+        return arguments(pout, own{});
+    }
+};
+
 /// A program represents the all computation graphs to be compiled and executed
 struct program : MIGRAPHX_HANDLE_BASE(program)
 {
@@ -881,6 +929,56 @@ struct program : MIGRAPHX_HANDLE_BASE(program)
         return arguments(pout, own{});
     }
 
+    /// Run the program using the inputs passed in and the options, such as the output buffers
+    arguments eval(const program_parameters& pparams, const run_options& poptions) const
+    {
+        migraphx_arguments_t pout;
+        call(&migraphx_program_run_with_options,
+             &pout,
+             this->get_handle_ptr(),
+             pparams.get_handle_ptr(),
+             poptions.get_handle_ptr());
+        return arguments(pout, own{});
+    }
+
+    /// Run the program on another thread. The program, the inputs and the bound outputs must be
+    /// kept alive, and the program must not be run again, until the run has finished.
+    run_future eval_async(const program_parameters& pparams, const run_options& poptions) const
+    {
+        migraphx_run_future_t pout;
+        call(&migraphx_program_run_async,
+             &pout,
+             this->get_handle_ptr(),
+             pparams.get_handle_ptr(),
+             poptions.get_handle_ptr(),
+             nullptr,
+             nullptr);
+        return run_future(pout, own{});
+    }
+
+    /// Run the program on another thread, and call `f` with the status of the run from that
+    /// thread when it has finished
+    template <class F>
+    run_future eval_async(const program_parameters& pparams, const run_options& poptions, F f) const
+    {
+        using callback = std::function<void(migraphx_status)>;
+        std::unique_ptr<callback> pf(new callback(std::move(f))); // NOLINT
+        migraphx_run_future_t pout;
+        call(&migraphx_program_run_async,
+             &pout,
+             this->get_handle_ptr(),
+             pparams.get_handle_ptr(),
+             poptions.get_handle_ptr(),
+             [](migraphx_status status, void* data) {
+                 std::unique_ptr<callback> g(static_cast<callback*>(data));
+                 (*g)(status);
+             },
+             pf.get());
+        // The callback is deleted after it is called
+        pf.release();
+        return run_future(pout, own{});
+    }
+
     void print() const { call(&migraphx_program_print, this->get_handle_ptr()); }
 
     program sort()
@@ -1042,6 +1140,89 @@ inline program parse_onnx_buffer(const std::string& buffer)
         own{});
 }
 
+/// A family of programs for the same model, one for each batch size
+struct program_buckets : MIGRAPHX_HANDLE_BASE(program_buckets)
+{
+    program_buckets() { this->make_handle(&migraphx_program_buckets_create); }
+
+    MIGRAPHX_HANDLE_CONSTRUCTOR(program_buckets);
+
+    /// Add a program to be used for a batch size
+    void insert(size_t batch_size, const program& p) const
+    {
+        call(&migraphx_program_buckets_insert,
+             this->get_handle_ptr(),
+             batch_size,
+             p.get_handle_ptr());
+    }
+
+    /// Return the number of buckets
+    size_t size() const
+    {
+        size_t pout;
+        call(&migraphx_program_buckets_size, &pout, this->get_handle_ptr());
+        return pout;
+    }
+
+    /// Return the batch size of the smallest bucket that can run the batch size
+    size_t select(size_t batch_size) const
+    {
+        size_t pout;
+        call(&migraphx_program_buckets_select, &pout, this->get_handle_ptr(), batch_size);
+        return pout;
+    }
+
+    /// Compile all the programs for a specific target to be ran on
+    void compile(const target& ptarget, const compile_options& poptions) const
+    {
+        call(&migraphx_program_buckets_compile,
+             this->get_handle_ptr(),
+             ptarget.get_handle_ptr(),
+             poptions.get_handle_ptr());
+    }
+
+    /// Compile all the programs for a specific target to be ran on
+    void compile(const target& ptarget) const
+    {
+        call(&migraphx_program_buckets_compile,
+             this->get_handle_ptr(),
+             ptarget.get_handle_ptr(),
+             migraphx::compile_options{}.get_handle_ptr());
+    }
+
+    /// Run the smallest program that fits the batch size of the inputs. The batched inputs are
+    /// padded to the batch size of the program, and the padding is removed from the outputs.
+    arguments eval(const program_parameters& pparams) const
+    {
+        migraphx_arguments_t pout;
+        call(&migraphx_program_buckets_run,
+             &pout,
+             this->get_handle_ptr(),
+             pparams.get_handle_ptr());
+        return arguments(pout, own{});
+    }
+};
+
+/// Parse an onnx file into a program for each batch size
+inline program_buckets parse_onnx_buckets(const char* filename,
+                                          std::vector<size_t> batch_sizes,
+                                          const migraphx::onnx_options& options)
+{
+    return program_buckets(make<migraphx_program_buckets>(&migraphx_parse_onnx_buckets,
+                                                          filename,
+                                                          batch_sizes.data(),
+                                                          batch_sizes.size(),
+                                                          options.get_handle_ptr()),
+                           own{});
+}
+
+/// Parse an onnx file into a program for each batch size
+inline program_buckets parse_onnx_buckets(const char* filename, std::vector<size_t> batch_sizes)
+{
+    migraphx::onnx_options options;
+    return parse_onnx_buckets(filename, std::move(batch_sizes), options);
+}
+
 /// Options for parsing tf options
 struct tf_options : MIGRAPHX_HANDLE_BASE(tf_options)
 {
@@ -246,6 +246,20 @@ def program(h):
                  params='std::unordered_map<std::string, migraphx::argument>'),
              invoke='migraphx::run($@)',
              returns='std::vector<migraphx::argument>')
+    h.method('run_with_options',
+             api.params(
+                 params='std::unordered_map<std::string, migraphx::argument>',
+                 options='const migraphx::run_options&'),
+             invoke='migraphx::run($@)',
+             returns='std::vector<migraphx::argument>')
+    h.method('run_async',
+             api.params(
+                 params='std::unordered_map<std::string, migraphx::argument>',
+                 options='const migraphx::run_options&',
+                 callback='migraphx_run_callback',
+                 data='void*'),
+             invoke='migraphx::run_async($@)',
+             returns='migraphx::run_future')
     h.method('equal',
              api.params(x='const migraphx::program&'),
              invoke='migraphx::equal($@)',
@@ -257,6 +271,25 @@ def program(h):
              returns='migraphx::context')
 
 
+@auto_handle()
+def run_options(h):
+    h.constructor('create')
+    h.method('bind_output',
+             api.params(name='const char*',
+                        argument='const migraphx::argument&'),
+             invoke='migraphx::bind_output($@)')
+    h.method('set_copy_outputs',
+             api.params(value='bool'),
+             invoke='migraphx::set_copy_outputs($@)')
+
+
+@auto_handle()
+def run_future(h):
+    h.method('ready', returns='bool', const=True)
+    h.method('wait', const=True)
+    h.method('get', returns='std::vector<migraphx::argument>', const=True)
+
+
 @auto_handle()
 def operation(h):
     h.constructor('create',
@@ -333,6 +366,35 @@ api.add_function('migraphx_parse_onnx_buffer',
                  returns='migraphx::program')
 
 
+@auto_handle()
+def program_buckets(h):
+    h.constructor('create')
+    h.method('insert',
+             api.params(batch_size='size_t', program='const migraphx::program&'))
+    h.method('size', returns='size_t', const=True)
+    h.method('select',
+             api.params(batch_size='size_t'),
+             returns='size_t',
+             const=True)
+    h.method(
+        'compile',
+        api.params(target='migraphx::target',
+                   options='migraphx::compile_options'))
+    h.method('run',
+             api.params(
+                 params='std::unordered_map<std::string, migraphx::argument>'),
+             invoke='migraphx::run($@)',
+             returns='std::vector<migraphx::argument>')
+
+
+api.add_function('migraphx_parse_onnx_buckets',
+                 api.params(name='const char*',
+                            batch_sizes='std::vector<size_t>',
+                            options='migraphx::onnx_options'),
+                 fname='migraphx::parse_onnx_buckets',
+                 returns='migraphx::program_buckets')
+
+
 @auto_handle()
 def tf_options(h):
     h.constructor('create')
@@ -0,0 +1,159 @@
+#include "benchmarks.hpp"
+#include <migraphx/make_op.hpp>
+#include <migraphx/op/pooling.hpp>
+#include <migraphx/stringutils.hpp>
+
+namespace migraphx {
+namespace bench {
+inline namespace MIGRAPHX_INLINE_NS {
+
+std::vector<shape> benchmark::get_inputs(shape::type_t t) const
+{
+    std::vector<shape> result;
+    std::transform(inputs.begin(), inputs.end(), std::back_inserter(result), [&](const shape& s) {
+        if(s.type() != shape::float_type)
+            return s;
+        return shape{t, s.lens(), s.strides()};
+    });
+    return result;
+}
+
+program benchmark::create_program(shape::type_t t) const
+{
+    program p;
+    auto* mm = p.get_main_module();
+    std::vector<instruction_ref> args;
+    auto shapes = get_inputs(t);
+    for(std::size_t i = 0; i < shapes.size(); i++)
+        args.push_back(mm->add_parameter("x" + std::to_string(i), shapes[i]));
+    mm->add_instruction(op, args);
+    return p;
+}
+
+// The number of operations of each output element
+static auto per_output(double n)
+{
+    return [=](const std::vector<shape>&, const shape& output) { return n * output.elements(); };
+}
+
+// Reductions and normalizations do a few operations for each input element
+static auto per_input(double n)
+{
+    return [=](const std::vector<shape>& inputs, const shape&) {
+        return n * inputs.front().elements();
+    };
+}
+
+static double dot_flops(const std::vector<shape>& inputs, const shape& output)
+{
+    return 2.0 * output.elements() * inputs.front().lens().back();
+}
+
+static double convolution_flops(const std::vector<shape>& inputs, const shape& output)
+{
+    const auto& weights = inputs.at(1);
+    return 2.0 * output.elements() * (weights.elements() / weights.lens().front());
+}
+
+static shape nhwc(const std::vector<std::size_t>& lens)
+{
+    return {shape::float_type, lens, {lens[1] * lens[2] * lens[3], 1, lens[1] * lens[3], lens[1]}};
+}
+
+std::vector<benchmark> get_benchmarks()
+{
+    using shapes = std::vector<shape>;
+    const shape activation{shape::float_type, {8, 64, 56, 56}};
+    const shape reduce_input{shape::float_type, {8, 256, 32, 128}};
+    const shape vocab{shape::float_type, {4, 32000}};
+    const shape scores{shape::float_type, {2, 12, 128, 128}};
+    std::vector<benchmark> result = {
+        {"relu", make_op("relu"), {activation}, per_output(1)},
+        {"exp", make_op("exp"), {activation}, per_output(1)},
+        {"tanh", make_op("tanh"), {activation}, per_output(1)},
+        {"sigmoid", make_op("sigmoid"), {activation}, per_output(1)},
+        {"add", make_op("add"), {activation, activation}, per_output(1)},
+        {"mul", make_op("mul"), {activation, activation}, per_output(1)},
+        {"convert", make_op("convert", {{"target_type", shape::int8_type}}), {activation}},
+        {"contiguous/nhwc", make_op("contiguous"), {nhwc({8, 64, 56, 56})}},
+        {"concat/channels", make_op("concat", {{"axis", 1}}), {activation, activation}},
+        {"dot/gemv",
+         make_op("dot"),
+         shapes{{shape::float_type, {1, 4096}}, {shape::float_type, {4096, 4096}}},
+         dot_flops},
+        {"dot/bert",
+         make_op("dot"),
+         shapes{{shape::float_type, {512, 768}}, {shape::float_type, {768, 3072}}},
+         dot_flops},
+        {"dot/attention",
+         make_op("dot"),
+         shapes{{shape::float_type, {12, 128, 64}}, {shape::float_type, {12, 64, 128}}},
+         dot_flops},
+        {"dequant_dot/int8",
+         make_op("dequant_dot"),
+         shapes{{shape::float_type, {1, 4096}},
+                {shape::int8_type, {4096, 4096}},
+                {shape::float_type, {4096, 1}}},
+         dot_flops},
+        {"dequant_dot/int4",
+         make_op("dequant_dot", {{"bits", 4}, {"group_size", 128}}),
+         shapes{{shape::float_type, {1, 4096}},
+                {shape::uint8_type, {4096, 2048}},
+                {shape::float_type, {4096, 32}}},
+         dot_flops},
+        {"convolution/3x3",
+         make_op("convolution", {{"padding", {1, 1}}}),
+         shapes{{shape::float_type, {1, 64, 56, 56}}, {shape::float_type, {64, 64, 3, 3}}},
+         convolution_flops},
+        {"convolution/1x1",
+         make_op("convolution"),
+         shapes{{shape::float_type, {1, 256, 56, 56}}, {shape::float_type, {64, 256, 1, 1}}},
+         convolution_flops},
+        {"convolution/stem",
+         make_op("convolution", {{"padding", {3, 3}}, {"stride", {2, 2}}}),
+         shapes{{shape::float_type, {1, 3, 224, 224}}, {shape::float_type, {64, 3, 7, 7}}},
+         convolution_flops},
+        {"pooling/max",
+         make_op("pooling",
+                 {{"mode", op::pooling_mode::max},
+                  {"lengths", {3, 3}},
+                  {"stride", {2, 2}},
+                  {"padding", {1, 1}}}),
+         shapes{{shape::float_type, {1, 64, 112, 112}}},
+         per_output(9)},
+        {"pooling/global_average",
+         make_op("pooling", {{"mode", op::pooling_mode::average}, {"lengths", {7, 7}}}),
+         shapes{{shape::float_type, {1, 2048, 7, 7}}},
+         per_output(49)},
+        {"softmax/vocab", make_op("softmax", {{"axis", 1}}), {vocab}, per_input(4)},
+        {"softmax/attention", make_op("softmax", {{"axis", 3}}), {scores}, per_input(4)},
+        {"softmax/strided", make_op("softmax", {{"axis", 2}}), {scores}, per_input(4)},
+        {"logsoftmax/vocab", make_op("logsoftmax", {{"axis", 1}}), {vocab}, per_input(4)},
+        {"reduce_mean/spatial",
+         make_op("reduce_mean", {{"axes", {2, 3}}}),
+         {reduce_input},
+         per_input(1)},
+        {"reduce_max/inner", make_op("reduce_max", {{"axes", {3}}}), {reduce_input}, per_input(1)},
+    };
+    // The reductions over each choice of axes, which take different paths in the kernels
+    for(const auto& axes : std::vector<std::vector<int64_t>>{{3}, {2, 3}, {1}, {0}, {1, 3}})
+    {
+        std::vector<std::string> names;
+        std::transform(axes.begin(), axes.end(), std::back_inserter(names), [](auto axis) {
+            return std::to_string(axis);
+        });
+        result.push_back({"reduce_sum/axes=" + join_strings(names, "_"),
+                          make_op("reduce_sum", {{"axes", axes}}),
+                          {reduce_input},
+                          per_input(1)});
+    }
+    result.push_back({"reduce_sum/all",
+                      make_op("reduce_sum", {{"axes", {0, 1, 2, 3}}}),
+                      {reduce_input},
+                      per_input(1)});
+    return result;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace bench
+} // namespace migraphx
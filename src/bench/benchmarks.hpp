@@ -0,0 +1,37 @@
+#ifndef MIGRAPHX_GUARD_BENCH_BENCHMARKS_HPP
+#define MIGRAPHX_GUARD_BENCH_BENCHMARKS_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/operation.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/shape.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+namespace bench {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// An operator with the shapes of its inputs, which is run by itself on each target
+struct benchmark
+{
+    std::string name;
+    operation op;
+    /// The inputs of float type are created with the type that is benchmarked
+    std::vector<shape> inputs;
+    /// Number of floating-point operations for the inputs and the output, or 0 when it is not
+    /// meaningful for the operator
+    std::function<double(const std::vector<shape>& inputs, const shape& output)> flops = nullptr;
+
+    std::vector<shape> get_inputs(shape::type_t t) const;
+    program create_program(shape::type_t t) const;
+};
+
+std::vector<benchmark> get_benchmarks();
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace bench
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,255 @@
+#include "benchmarks.hpp"
+#include "argument_parser.hpp"
+
+#include <migraphx/errors.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/time.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <set>
+
+namespace migraphx {
+namespace bench {
+inline namespace MIGRAPHX_INLINE_NS {
+
+using milliseconds = std::chrono::duration<double, std::milli>;
+
+struct bench_result
+{
+    double time_ms = 0;
+    double gbps    = 0;
+    double gflops  = 0;
+};
+
+struct bench_options
+{
+    std::vector<std::string> targets;
+    std::vector<std::string> types;
+    std::vector<std::string> filters;
+    std::size_t iterations = 20;
+    std::string baseline;
+    std::string output;
+    double threshold = 0.1;
+    bool list        = false;
+
+    void parse(driver::argument_parser& ap)
+    {
+        ap(nullptr, {"-h", "--help"}, ap.help("Show help"), ap.show_help());
+        ap(targets,
+           {"--target", "-t"},
+           ap.help("Target to run on, all the registered targets by default"),
+           ap.append());
+        ap(types, {"--type"}, ap.help("Type of the inputs, float by default"), ap.append());
+        ap(filters,
+           {"--filter", "-f"},
+           ap.help("Only run the benchmarks whose name contains the string"),
+           ap.append());
+        ap(iterations, {"--iterations", "-n"}, ap.help("Number of timed runs of each benchmark"));
+        ap(baseline, {"--baseline"}, ap.help("JSON file of results to compare with"));
+        ap(output,
+           {"--output", "-o"},
+           ap.help("Write the results to a JSON file, which can be used as a baseline"));
+        ap(threshold,
+           {"--threshold"},
+           ap.help("Slowdown relative to the baseline that is reported as a regression"));
+        ap(list,
+           {"--list"},
+           ap.help("List the benchmarks and the operators that have none"),
+           ap.set_value(true));
+    }
+
+    bool selected(const std::string& name) const
+    {
+        return filters.empty() or std::any_of(filters.begin(), filters.end(), [&](auto& f) {
+                   return contains(name, f);
+               });
+    }
+};
+
+// Accepts the name of the type with or without the suffix, or the C++ type
+static shape::type_t get_type(const std::string& name)
+{
+    for(auto t : shape::types())
+    {
+        if(t == shape::tuple_type)
+            continue;
+        if(contains({name, name + "_type"}, shape::name(t)) or shape::cpp_type(t) == name)
+            return t;
+    }
+    MIGRAPHX_THROW("Unknown type: " + name);
+}
+
+// Runs the operator by itself, and returns the median of the timed runs
+static bench_result
+run(const benchmark& b, const std::string& target_name, shape::type_t t, std::size_t iterations)
+{
+    auto p      = b.create_program(t);
+    auto output = p.get_output_shapes().back();
+    auto tgt    = make_target(target_name);
+    p.compile(tgt);
+    parameter_map params;
+    for(auto&& x : p.get_parameter_shapes())
+        params[x.first] = tgt.copy_to(generate_argument(x.second));
+    auto& ctx = p.get_context();
+    p.eval(params);
+    ctx.finish();
+    std::vector<double> times;
+    for(std::size_t i = 0; i < std::max<std::size_t>(iterations, 1); i++)
+    {
+        times.push_back(time<milliseconds>([&] {
+            p.eval(params);
+            ctx.finish();
+        }));
+    }
+    std::sort(times.begin(), times.end());
+
+    auto inputs = b.get_inputs(t);
+    double bytes =
+        std::accumulate(inputs.begin(), inputs.end(), double(output.bytes()), [](auto x, auto s) {
+            return x + s.bytes();
+        });
+    bench_result result;
+    result.time_ms = times[times.size() / 2];
+    result.gbps    = bytes / (result.time_ms * 1e6);
+    if(b.flops)
+        result.gflops = b.flops(inputs, output) / (result.time_ms * 1e6);
+    return result;
+}
+
+static void list_benchmarks(const std::vector<benchmark>& benchmarks)
+{
+    std::set<std::string> covered;
+    for(const auto& b : benchmarks)
+    {
+        std::cout << b.name << ": " << b.op.name() << " " << to_string_range(b.inputs)
+                  << std::endl;
+        covered.insert(b.op.name());
+    }
+    // The operators of the targets have a namespace and are benchmarked through the generic ones
+    std::vector<std::string> missing;
+    for(const auto& name : get_operators())
+    {
+        if(not contains(name, "::") and not starts_with(name, "@") and not contains(covered, name))
+            missing.push_back(name);
+    }
+    std::sort(missing.begin(), missing.end());
+    std::cout << std::endl << "Operators without a benchmark: " << join_strings(missing, ", ");
+    std::cout << std::endl;
+}
+
+static std::string format(double x, int precision)
+{
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(precision) << x;
+    return ss.str();
+}
+
+static int run_benchmarks(const bench_options& options)
+{
+    auto benchmarks = get_benchmarks();
+    if(options.list)
+    {
+        list_benchmarks(benchmarks);
+        return 0;
+    }
+    auto targets = options.targets.empty() ? get_targets() : options.targets;
+    std::vector<shape::type_t> types = {shape::float_type};
+    if(not options.types.empty())
+    {
+        types.clear();
+        std::transform(
+            options.types.begin(), options.types.end(), std::back_inserter(types), &get_type);
+    }
+    value baseline;
+    if(not options.baseline.empty())
+        baseline = from_json_string(read_string(options.baseline));
+
+    value results = value::object{};
+    std::size_t regressions = 0;
+    std::cout << std::left << std::setw(28) << "benchmark" << std::setw(8) << "target"
+              << std::setw(8) << "type" << std::right << std::setw(12) << "time (ms)"
+              << std::setw(10) << "GB/s" << std::setw(10) << "GFLOP/s" << "  baseline"
+              << std::endl;
+    for(const auto& target_name : targets)
+    {
+        for(auto t : types)
+        {
+            for(const auto& b : benchmarks)
+            {
+                if(not options.selected(b.name))
+                    continue;
+                auto key = target_name + "/" + shape::cpp_type(t) + "/" + b.name;
+                std::cout << std::left << std::setw(28) << b.name << std::setw(8) << target_name
+                          << std::setw(8) << shape::cpp_type(t) << std::right << std::flush;
+                bench_result r;
+                try
+                {
+                    r = run(b, target_name, t, options.iterations);
+                }
+                catch(const std::exception& e)
+                {
+                    std::cout << "  skipped: " << e.what() << std::endl;
+                    continue;
+                }
+                std::cout << std::setw(12) << format(r.time_ms, 4) << std::setw(10)
+                          << format(r.gbps, 2) << std::setw(10)
+                          << (b.flops ? format(r.gflops, 2) : "-");
+                if(baseline.contains(key))
+                {
+                    auto base  = baseline.at(key).at("time_ms").to<double>();
+                    auto ratio = r.time_ms / base;
+                    std::cout << "  " << format(ratio, 2) << "x";
+                    if(ratio > 1 + options.threshold)
+                    {
+                        std::cout << " REGRESSION";
+                        regressions++;
+                    }
+                }
+                std::cout << std::endl;
+                results[key] = {{"time_ms", r.time_ms}, {"gbps", r.gbps}, {"gflops", r.gflops}};
+            }
+        }
+    }
+    if(not options.output.empty())
+    {
+        auto json = to_pretty_json_string(results);
+        write_buffer(options.output, json.data(), json.size());
+    }
+    if(regressions > 0)
+    {
+        std::cout << regressions << " benchmarks are more than " << options.threshold * 100
+                  << "% slower than the baseline" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace bench
+} // namespace migraphx
+
+int main(int argc, const char* argv[])
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    migraphx::bench::bench_options options;
+    migraphx::driver::argument_parser ap;
+    options.parse(ap);
+    try
+    {
+        if(ap.parse(args))
+            return 0;
+        return migraphx::bench::run_benchmarks(options);
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
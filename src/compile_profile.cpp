@@ -0,0 +1,169 @@
+#include <migraphx/compile_profile.hpp>
+#include <migraphx/builtin.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// The scratch memory is the allocations, or the scratch parameter that replaces them once the
+// memory is planned
+static bool is_scratch(const instruction& ins)
+{
+    if(ends_with(ins.name(), "allocate"))
+        return true;
+    return ins.name() == "@param" and
+           any_cast<builtin::param>(ins.get_operator()).parameter == "scratch";
+}
+
+compile_profile::totals compile_profile::get_totals(const module& m)
+{
+    totals result;
+    result.instructions = m.size();
+    for(const auto& ins : m)
+    {
+        if(ins.name() == "@literal")
+            result.literal_bytes += ins.get_shape().bytes();
+        else if(is_scratch(ins))
+            result.scratch_bytes += ins.get_shape().bytes();
+    }
+    return result;
+}
+
+compile_profile::totals compile_profile::get_totals(const program& p)
+{
+    totals result;
+    for(const auto* m : p.get_modules())
+    {
+        auto t = get_totals(*m);
+        result.instructions += t.instructions;
+        result.literal_bytes += t.literal_bytes;
+        result.scratch_bytes += t.scratch_bytes;
+    }
+    return result;
+}
+
+void compile_profile::add(const std::string& pass,
+                          const std::string& module_name,
+                          const totals& before,
+                          const totals& after,
+                          double start_ms,
+                          double time_ms)
+{
+    pass_record r;
+    r.pass                = pass;
+    r.module              = module_name;
+    r.start_ms            = start_ms;
+    r.time_ms             = time_ms;
+    r.instructions_before = before.instructions;
+    r.instructions_after  = after.instructions;
+    r.literal_bytes       = after.literal_bytes;
+    r.scratch_bytes       = after.scratch_bytes;
+    records.push_back(r);
+}
+
+double compile_profile::total_ms() const
+{
+    if(records.empty())
+        return 0;
+    const auto& last = records.back();
+    return last.start_ms + last.time_ms;
+}
+
+// The time of each pass summed over the modules, with the slowest first
+static std::vector<std::pair<std::string, double>>
+pass_times(const std::vector<compile_profile::pass_record>& records)
+{
+    std::map<std::string, double> m;
+    for(const auto& r : records)
+        m[r.pass] += r.time_ms;
+    std::vector<std::pair<std::string, double>> result(m.begin(), m.end());
+    std::stable_sort(result.begin(), result.end(), [](const auto& x, const auto& y) {
+        return x.second > y.second;
+    });
+    return result;
+}
+
+value compile_profile::to_value() const
+{
+    value passes = value::array{};
+    for(const auto& r : records)
+    {
+        passes.push_back({{"pass", r.pass},
+                          {"module", r.module},
+                          {"start_ms", r.start_ms},
+                          {"time_ms", r.time_ms},
+                          {"instructions_before", r.instructions_before},
+                          {"instructions_after", r.instructions_after},
+                          {"literal_bytes", r.literal_bytes},
+                          {"scratch_bytes", r.scratch_bytes}});
+    }
+    value summary = value::array{};
+    for(const auto& p : pass_times(records))
+        summary.push_back({{"pass", p.first}, {"time_ms", p.second}});
+    return {{"target", target}, {"total_ms", total_ms()}, {"summary", summary}, {"passes", passes}};
+}
+
+value compile_profile::to_chrome_trace() const
+{
+    // Each module is shown as a thread, after the passes applied to the whole program
+    std::vector<std::string> threads = {""};
+    value events                     = value::array{};
+    for(const auto& r : records)
+    {
+        auto it = std::find(threads.begin(), threads.end(), r.module);
+        if(it == threads.end())
+            it = threads.insert(it, r.module);
+        events.push_back({{"name", r.pass},
+                          {"cat", "pass"},
+                          {"ph", "X"},
+                          {"ts", r.start_ms * 1000},
+                          {"dur", r.time_ms * 1000},
+                          {"pid", 0},
+                          {"tid", std::distance(threads.begin(), it)},
+                          {"args",
+                           {{"instructions_before", r.instructions_before},
+                            {"instructions_after", r.instructions_after},
+                            {"literal_bytes", r.literal_bytes},
+                            {"scratch_bytes", r.scratch_bytes}}}});
+    }
+    for(std::size_t i = 0; i < threads.size(); i++)
+    {
+        events.push_back({{"name", "thread_name"},
+                          {"ph", "M"},
+                          {"pid", 0},
+                          {"tid", i},
+                          {"args", {{"name", i == 0 ? "program" : threads[i]}}}});
+    }
+    return {{"traceEvents", events}, {"displayTimeUnit", "ms"}};
+}
+
+void compile_profile::print_summary(std::ostream& os, std::size_t n) const
+{
+    auto total = total_ms();
+    os << "Compile time for " << target << ": " << total << "ms" << std::endl;
+    auto times = pass_times(records);
+    if(times.size() > n)
+        times.resize(n);
+    for(const auto& p : times)
+    {
+        os << std::setw(36) << std::left << p.first << ": " << p.second << "ms, "
+           << (total > 0 ? 100.0 * p.second / total : 0.0) << "%" << std::endl;
+    }
+}
+
+void compile_profile::write(const std::string& filename, bool chrome_trace) const
+{
+    auto json = to_pretty_json_string(chrome_trace ? to_chrome_trace() : to_value());
+    write_buffer(filename, json.data(), json.size());
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
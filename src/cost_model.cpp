@@ -0,0 +1,157 @@
+#include <migraphx/cost_model.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// The number of multiply-adds for each element of the output, or of the input for a
+// deconvolution, which is the size of the weights divided by the number of output channels
+static double macs_per_element(const shape& weights)
+{
+    if(weights.lens().empty() or weights.lens().front() == 0)
+        return 1;
+    return static_cast<double>(weights.elements()) / weights.lens().front();
+}
+
+static double get_flops(instruction_ref ins)
+{
+    const auto& inputs = ins->inputs();
+    auto name          = ins->name();
+    auto out           = ins->get_shape();
+    if(contains(name, "conv") and inputs.size() > 1)
+    {
+        auto elements =
+            contains(name, "deconv") ? inputs[0]->get_shape().elements() : out.elements();
+        return 2.0 * elements * macs_per_element(inputs[1]->get_shape());
+    }
+    if((contains(name, "gemm") or contains(name, "dot")) and inputs.size() > 1 and
+       not inputs[0]->get_shape().lens().empty())
+        return 2.0 * out.elements() * inputs[0]->get_shape().lens().back();
+    std::size_t elements = out.elements();
+    for(auto input : inputs)
+        elements = std::max(elements, input->get_shape().elements());
+    return elements;
+}
+
+instruction_cost estimate_cost(instruction_ref ins)
+{
+    instruction_cost result;
+    result.flops = get_flops(ins);
+    std::vector<shape> shapes;
+    std::transform(ins->inputs().begin(),
+                   ins->inputs().end(),
+                   std::back_inserter(shapes),
+                   [](auto input) { return input->get_shape(); });
+    // The input that the output aliases is written, not read
+    auto alias   = ins->get_operator().output_alias(shapes);
+    result.bytes = ins->get_shape().bytes();
+    for(std::size_t i = 0; i < shapes.size(); i++)
+    {
+        if(static_cast<std::ptrdiff_t>(i) != alias)
+            result.bytes += shapes[i].bytes();
+    }
+    return result;
+}
+
+std::string cost_key(instruction_ref ins)
+{
+    return to_string(ins->get_operator()) + " -> " + to_string(ins->get_shape());
+}
+
+// Parses a line such as `@3 = op[attributes](@1,@2) -> shape: 0.5ms, 10%`
+static bool parse_perf_line(const std::string& line, std::string& key, double& time)
+{
+    auto start = line.find(" = ");
+    auto arrow = line.rfind(" -> ");
+    auto colon = line.rfind(": ");
+    if(start == std::string::npos or arrow == std::string::npos or colon == std::string::npos or
+       arrow < start or colon < arrow)
+        return false;
+    auto op = line.substr(start + 3, arrow - start - 3);
+    // Remove the submodules and then the arguments
+    if(ends_with(op, "]") and contains(op, ", ["))
+        op = op.substr(0, op.rfind(", ["));
+    if(ends_with(op, ")"))
+        op = op.substr(0, op.rfind('('));
+    auto ms = line.find("ms", colon);
+    if(ms == std::string::npos)
+        return false;
+    try
+    {
+        time = std::stod(line.substr(colon + 2, ms - colon - 2));
+    }
+    catch(const std::exception&)
+    {
+        return false;
+    }
+    key = op + line.substr(arrow, colon - arrow);
+    return true;
+}
+
+std::unordered_map<std::string, double> read_perf_report(std::istream& is)
+{
+    std::unordered_map<std::string, std::pair<double, std::size_t>> sums;
+    std::string line;
+    while(std::getline(is, line))
+    {
+        std::string key;
+        double time = 0;
+        if(not parse_perf_line(line, key, time))
+            continue;
+        sums[key].first += time;
+        sums[key].second++;
+    }
+    // Instructions with the same operator and shape are averaged
+    std::unordered_map<std::string, double> result;
+    for(auto&& p : sums)
+        result[p.first] = p.second.first / p.second.second;
+    return result;
+}
+
+std::unordered_map<std::string, double> read_perf_report(const std::string& filename)
+{
+    std::ifstream is(filename);
+    if(not is.is_open())
+        MIGRAPHX_THROW("Failed to open perf report: " + filename);
+    return read_perf_report(is);
+}
+
+bool cost_model::empty() const { return flops <= 0 and bandwidth <= 0 and times.empty(); }
+
+double cost_model::time(instruction_ref ins) const
+{
+    if(not times.empty())
+    {
+        auto it = times.find(cost_key(ins));
+        if(it != times.end())
+            return it->second * 1000.0;
+    }
+    auto cost   = estimate_cost(ins);
+    double time = 0;
+    if(flops > 0)
+        time = std::max(time, cost.flops / flops);
+    if(bandwidth > 0)
+        time = std::max(time, cost.bytes / bandwidth);
+    return time * 1.0e6;
+}
+
+std::size_t cost_model::weight(instruction_ref ins) const
+{
+    // Anything faster than a microsecond has the smallest weight, since it is not worth a stream
+    return std::max<std::size_t>(1, std::lround(this->time(ins)));
+}
+
+std::size_t cost_model::partition_threshold() const
+{
+    return std::max<std::size_t>(1, std::lround(partition_time));
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,260 @@
+#include "inputs.hpp"
+
+#include <migraphx/errors.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace migraphx {
+namespace driver {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// The mapping is private so the data can be written to without changing the file
+static std::shared_ptr<char> map_file(const std::string& filename, std::size_t& size)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if(fd < 0)
+        MIGRAPHX_THROW("Failed to open file: " + filename);
+    struct stat st
+    {
+    };
+    if(fstat(fd, &st) != 0 or st.st_size == 0)
+    {
+        close(fd);
+        MIGRAPHX_THROW("Empty file: " + filename);
+    }
+    size    = st.st_size;
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(p == MAP_FAILED)
+        MIGRAPHX_THROW("Failed to map file: " + filename);
+    return {static_cast<char*>(p), [size](char* x) { munmap(x, size); }};
+}
+
+static shape::type_t get_npy_type(const std::string& descr)
+{
+    if(descr.size() < 2 or not contains({'<', '|', '='}, descr.front()))
+        MIGRAPHX_THROW("Unsupported byte order of npy type: " + descr);
+    static const std::unordered_map<std::string, shape::type_t> types = {
+        {"b1", shape::bool_type},
+        {"f2", shape::half_type},
+        {"f4", shape::float_type},
+        {"f8", shape::double_type},
+        {"u1", shape::uint8_type},
+        {"i1", shape::int8_type},
+        {"u2", shape::uint16_type},
+        {"i2", shape::int16_type},
+        {"i4", shape::int32_type},
+        {"i8", shape::int64_type},
+        {"u4", shape::uint32_type},
+        {"u8", shape::uint64_type},
+    };
+    auto it = types.find(descr.substr(1));
+    if(it == types.end())
+        MIGRAPHX_THROW("Unsupported npy type: " + descr);
+    return it->second;
+}
+
+// The text after the key of the header dictionary
+static std::string get_npy_field(const std::string& header, const std::string& key)
+{
+    auto pos = header.find("'" + key + "'");
+    if(pos == std::string::npos)
+        MIGRAPHX_THROW("Missing " + key + " in npy header: " + header);
+    pos = header.find(':', pos);
+    return trim(header.substr(pos + 1));
+}
+
+argument load_npy(const std::string& filename)
+{
+    std::size_t size = 0;
+    auto data        = map_file(filename, size);
+    if(size < 10 or std::memcmp(data.get(), "\x93NUMPY", 6) != 0)
+        MIGRAPHX_THROW("Not a npy file: " + filename);
+    // Version 1 has a 2 byte header length, and the later versions a 4 byte one
+    auto major              = static_cast<unsigned char>(data.get()[6]);
+    std::size_t header_len  = 0;
+    std::size_t header_from = major == 1 ? 10 : 12;
+    if(size < header_from)
+        MIGRAPHX_THROW("Truncated npy file: " + filename);
+    for(std::size_t i = header_from; i > 8; i--)
+        header_len = header_len * 256 + static_cast<unsigned char>(data.get()[i - 1]);
+    auto offset = header_from + header_len;
+    if(size < offset)
+        MIGRAPHX_THROW("Truncated npy file: " + filename);
+    std::string header(data.get() + header_from, header_len);
+
+    auto descr = get_npy_field(header, "descr");
+    descr      = descr.substr(1, descr.find('\'', 1) - 1);
+    auto t     = get_npy_type(descr);
+
+    auto dims = get_npy_field(header, "shape");
+    dims      = dims.substr(1, dims.find(')') - 1);
+    std::vector<std::size_t> lens;
+    for(const auto& d : split_string(dims, ','))
+    {
+        if(not trim(d).empty())
+            lens.push_back(std::stoul(trim(d)));
+    }
+
+    shape s{t};
+    if(not lens.empty())
+        s = shape{t, lens};
+    if(starts_with(get_npy_field(header, "fortran_order"), "True"))
+    {
+        // Column major, so the first dimension is the fastest
+        std::vector<std::size_t> strides(lens.size());
+        std::size_t stride = 1;
+        for(std::size_t i = 0; i < lens.size(); i++)
+        {
+            strides[i] = stride;
+            stride *= lens[i];
+        }
+        s = shape{t, lens, strides};
+    }
+    if(size < offset + s.bytes())
+        MIGRAPHX_THROW("Truncated npy file: " + filename);
+    return {s, std::shared_ptr<char>(data, data.get() + offset)};
+}
+
+argument load_binary(const std::string& filename, const shape& s)
+{
+    std::size_t size = 0;
+    auto data        = map_file(filename, size);
+    if(size != s.bytes())
+    {
+        MIGRAPHX_THROW("File " + filename + " has " + std::to_string(size) +
+                       " bytes instead of the " + std::to_string(s.bytes()) + " bytes of " +
+                       to_string(s));
+    }
+    return {s, data};
+}
+
+static std::string get_file_name(const std::string& name)
+{
+    std::string result = name;
+    std::replace_if(
+        result.begin(),
+        result.end(),
+        [](char c) { return not(std::isalnum(c) or contains({'_', '-', '.'}, c)); },
+        '_');
+    return result;
+}
+
+// Loads the inputs of the parameters that have a file in the directory
+static parameter_map load_input_set(const fs::path& dir, const program& p)
+{
+    parameter_map m;
+    for(auto&& x : p.get_parameter_shapes())
+    {
+        auto name = get_file_name(x.first);
+        auto npy  = dir / (name + ".npy");
+        auto bin  = dir / (name + ".bin");
+        const shape s{x.second.type(), x.second.lens()};
+        if(fs::exists(npy))
+        {
+            auto arg = load_npy(npy.string());
+            if(arg.get_shape().type() != s.type() or arg.get_shape().elements() != s.elements())
+            {
+                MIGRAPHX_THROW("File " + npy.string() + " has shape " +
+                               to_string(arg.get_shape()) + " instead of " + to_string(s));
+            }
+            // Column major data is copied, as the parameters have the standard layout
+            if(not arg.get_shape().standard())
+            {
+                argument result{shape{s.type(), arg.get_shape().lens()}};
+                visit_all(result, arg)([](auto output, auto input) {
+                    std::copy(input.begin(), input.end(), output.begin());
+                });
+                arg = result;
+            }
+            // A parameter of a different rank, such as without the batch dimension, is reshaped
+            if(arg.get_shape().lens() != s.lens())
+                arg = arg.reshape(s);
+            m[x.first] = arg;
+        }
+        else if(fs::exists(bin))
+        {
+            m[x.first] = load_binary(bin.string(), s);
+        }
+    }
+    if(m.empty())
+        MIGRAPHX_THROW("No inputs of the parameters in " + dir.string());
+    return m;
+}
+
+std::vector<parameter_map> load_input_sets(const std::string& dir, const program& p)
+{
+    fs::path root{dir};
+    if(not fs::is_directory(root))
+        MIGRAPHX_THROW("Not a directory: " + dir);
+    std::vector<fs::path> dirs;
+    for(const auto& entry : fs::directory_iterator{root})
+    {
+        if(fs::is_directory(entry.path()))
+            dirs.push_back(entry.path());
+    }
+    // The sets are used in the order of the names of the directories
+    std::sort(dirs.begin(), dirs.end());
+    if(dirs.empty())
+        dirs.push_back(root);
+    std::vector<parameter_map> result;
+    std::transform(dirs.begin(), dirs.end(), std::back_inserter(result), [&](const auto& d) {
+        return load_input_set(d, p);
+    });
+    return result;
+}
+
+// 64 bit FNV-1a hash of the bytes
+static std::uint64_t hash_bytes(const argument& arg, std::uint64_t h)
+{
+    if(arg.get_shape().type() == shape::tuple_type)
+    {
+        for(const auto& sub : arg.get_sub_objects())
+            h = hash_bytes(sub, h);
+        return h;
+    }
+    const auto* data = reinterpret_cast<const unsigned char*>(arg.data());
+    for(std::size_t i = 0; i < arg.get_shape().bytes(); i++)
+    {
+        h ^= data[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+std::string checksum(const argument& arg)
+{
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0')
+       << hash_bytes(arg, 14695981039346656037ULL);
+    return ss.str();
+}
+
+void flush_cache()
+{
+    static std::vector<char> buffer = [] {
+        long llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+        if(llc <= 0)
+            llc = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        std::size_t n = llc > 0 ? 4 * llc : 64 * 1024 * 1024;
+        return std::vector<char>(n);
+    }();
+    static char value = 0;
+    value++;
+    std::fill(buffer.begin(), buffer.end(), value);
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace driver
+} // namespace migraphx
@@ -0,0 +1,35 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_DRIVER_INPUTS_HPP
+#define MIGRAPHX_GUARD_RTGLIB_DRIVER_INPUTS_HPP
+
+#include <migraphx/program.hpp>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+namespace driver {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// Maps a numpy .npy file, whose data is used in place
+argument load_npy(const std::string& filename);
+// Maps a file of raw data with the shape
+argument load_binary(const std::string& filename, const shape& s);
+
+/**
+ * Loads the input sets from a directory. Each subdirectory is an input set, or the directory
+ * itself when it has none. The input of a parameter is read from `<name>.npy` or `<name>.bin`,
+ * where the characters of the name that are not allowed in a file name are replaced with `_`.
+ * Parameters without a file are left out of the set.
+ */
+std::vector<parameter_map> load_input_sets(const std::string& dir, const program& p);
+
+// A hash of the data of the argument, to check that runs are reproducible
+std::string checksum(const argument& arg);
+
+// Evicts the host caches by writing to a buffer larger than the last level cache
+void flush_cache();
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace driver
+} // namespace migraphx
+
+#endif
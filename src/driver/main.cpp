@@ -3,15 +3,20 @@
 #include "command.hpp"
 #include "precision.hpp"
 #include "perf.hpp"
+#include "inputs.hpp"
 #include "models.hpp"
 #include "marker_roctx.hpp"
+#include "marker_perf.hpp"
 
 #include <migraphx/tf.hpp>
+#include <migraphx/compile_profile.hpp>
+#include <migraphx/file_buffer.hpp>
 #include <migraphx/onnx.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/load_save.hpp>
 #include <migraphx/json.hpp>
 #include <migraphx/version.h>
+#include <migraphx/time.hpp>
 
 #include <migraphx/dead_code_elimination.hpp>
 #include <migraphx/eliminate_identity.hpp>
@@ -25,8 +30,12 @@
 #include <migraphx/simplify_algebra.hpp>
 #include <migraphx/simplify_reshapes.hpp>
 #include <migraphx/register_target.hpp>
+#include <migraphx/request_batcher.hpp>
 
+#include <cstdlib>
 #include <fstream>
+#include <numeric>
+#include <random>
 
 namespace migraphx {
 namespace driver {
@@ -248,21 +257,37 @@ struct program_params
 {
     std::vector<std::string> fill0{};
     std::vector<std::string> fill1{};
+    std::string input_dir;
     void parse(argument_parser& ap)
     {
         ap(fill0, {"--fill0"}, ap.help("Fill parameter with 0s"), ap.append(), ap.nargs(2));
         ap(fill1, {"--fill1"}, ap.help("Fill parameter with 1s"), ap.append(), ap.nargs(2));
+        ap(input_dir,
+           {"--input-dir"},
+           ap.help("Directory of .npy or .bin files named after the parameters, or of "
+                   "subdirectories with an input set each"));
+    }
+
+    // The input sets of the directory, with the parameters they miss generated
+    std::vector<parameter_map> generate_sets(const program& p, const target& t, bool offload)
+    {
+        std::vector<parameter_map> sets(1);
+        if(not input_dir.empty())
+            sets = load_input_sets(input_dir, p);
+        for(auto& m : sets)
+        {
+            for(auto&& s : fill0)
+                m[s] = fill_argument(p.get_parameter_shape(s), 0);
+            for(auto&& s : fill1)
+                m[s] = fill_argument(p.get_parameter_shape(s), 1);
+            fill_param_map(m, p, t, offload);
+        }
+        return sets;
     }
 
     auto generate(const program& p, const target& t, bool offload)
     {
-        parameter_map m;
-        for(auto&& s : fill0)
-            m[s] = fill_argument(p.get_parameter_shape(s), 0);
-        for(auto&& s : fill1)
-            m[s] = fill_argument(p.get_parameter_shape(s), 1);
-        fill_param_map(m, p, t, offload);
-        return m;
+        return generate_sets(p, t, offload).front();
     }
 };
 
@@ -295,6 +320,14 @@ struct compiler
     bool offload_copy  = false;
     bool fast_math     = true;
     precision quantize = precision::fp32;
+    double fp16_budget = 0;
+    std::string fp16_plan;
+    std::string fp16_plan_output;
+    std::string profile_file;
+    std::string profile_trace;
+    bool profile_summary = false;
+    // Settings of the context of the target, see compile_options::context
+    value context = {};
 
     std::vector<std::string> fill0;
     std::vector<std::string> fill1;
@@ -313,10 +346,33 @@ struct compiler
            ap.set_value(false));
         ap(quantize, {"--fp16"}, ap.help("Quantize for fp16"), ap.set_value(precision::fp16));
         ap(quantize, {"--int8"}, ap.help("Quantize for int8"), ap.set_value(precision::int8));
+        ap(fp16_budget,
+           {"--fp16-search"},
+           ap.help("Search for the instructions to quantize for fp16 with the rms error of the "
+                   "outputs within the budget, with the input sets as calibration data"));
+        ap(fp16_plan, {"--fp16-plan"}, ap.help("Quantize the instructions of a fp16 plan file"));
+        ap(fp16_plan_output,
+           {"--fp16-plan-output"},
+           ap.help("Write the plan found by --fp16-search to a file"));
+        ap(profile_file,
+           {"--profile"},
+           ap.help("Write the time and the effect of each compile pass to a JSON file"));
+        ap(profile_trace,
+           {"--profile-trace"},
+           ap.help("Write the compile passes to a file in the Chrome trace event format"));
+        ap(profile_summary,
+           {"--profile-summary"},
+           ap.help("Print the compile passes that take the most time"),
+           ap.set_value(true));
     }
 
     auto params(const program& p) { return parameters.generate(p, ct.get_target(), offload_copy); }
 
+    auto param_sets(const program& p)
+    {
+        return parameters.generate_sets(p, ct.get_target(), offload_copy);
+    }
+
     program compile()
     {
         auto p = l.load();
@@ -332,10 +388,38 @@ struct compiler
         {
             quantize_int8(p, t, {params(p)});
         }
+        if(not fp16_plan.empty())
+        {
+            quantize_fp16_plan(p, from_json_string(read_string(fp16_plan)));
+        }
+        else if(fp16_budget > 0)
+        {
+            auto plan = search_fp16_plan(p, t, parameters.generate_sets(p, t, true), fp16_budget);
+            std::cout << "Quantized " << plan.at("converted").size()
+                      << " instructions for fp16 and kept " << plan.at("kept").size()
+                      << " in fp32, with an error of " << plan.at("error").to<double>()
+                      << std::endl;
+            if(not fp16_plan_output.empty())
+            {
+                auto json = to_pretty_json_string(plan);
+                write_buffer(fp16_plan_output, json.data(), json.size());
+            }
+            quantize_fp16_plan(p, plan);
+        }
+        compile_profile profile;
         compile_options options;
         options.offload_copy = offload_copy;
         options.fast_math    = fast_math;
+        options.context      = context;
+        if(profile_summary or not profile_file.empty() or not profile_trace.empty())
+            options.profile = &profile;
         p.compile(t, options);
+        if(not profile_file.empty())
+            profile.write(profile_file);
+        if(not profile_trace.empty())
+            profile.write(profile_trace, true);
+        if(profile_summary)
+            profile.print_summary(std::cout);
         l.save(p);
         return p;
     }
@@ -344,11 +428,22 @@ struct compiler
 struct read : command<read>
 {
     loader l;
-    void parse(argument_parser& ap) { l.parse(ap); }
+    bool peak_memory = false;
+    void parse(argument_parser& ap)
+    {
+        l.parse(ap);
+        ap(peak_memory,
+           {"--peak-memory"},
+           ap.help("Print the peak resident memory used to load the graph"),
+           ap.set_value(true));
+    }
 
     void run()
     {
         auto p = l.load();
+        if(peak_memory)
+            std::cerr << "Peak memory: " << get_peak_memory() / (1024 * 1024) << "MiB"
+                      << std::endl;
         l.save(p);
     }
 };
@@ -409,7 +504,8 @@ struct verify : command<verify>
         options.offload_copy = offload_copy;
         options.fast_math    = fast_math;
         auto t               = ct.get_target();
-        auto m               = parameters.generate(p, t, true);
+        auto sets            = parameters.generate_sets(p, t, true);
+        const auto& m        = sets.front();
 
         if(per_instruction)
         {
@@ -421,7 +517,13 @@ struct verify : command<verify>
         }
         else
         {
-            verify_program(l.file, p, t, options, quantize, m, tolerance);
+            for(std::size_t i = 0; i < sets.size(); i++)
+            {
+                auto name = l.file;
+                if(sets.size() > 1)
+                    name += " (input set " + std::to_string(i) + ")";
+                verify_program(name, p, t, options, quantize, sets[i], tolerance);
+            }
         }
     }
 };
@@ -468,20 +570,228 @@ struct perf : command<perf>
 {
     compiler c;
     unsigned n = 100;
+    std::vector<std::string> numa_policies;
+    bool cold_cache = false;
     void parse(argument_parser& ap)
     {
         c.parse(ap);
         ap(n, {"--iterations", "-n"}, ap.help("Number of iterations to run for perf report"));
+        ap(numa_policies,
+           {"--numa-policy"},
+           ap.help("Compare the numa policies of the cpu target (format: \"none spread local\")"),
+           ap.append());
+        ap(cold_cache,
+           {"--cold-cache"},
+           ap.help("Flush the host caches before each iteration instead of running warm"),
+           ap.set_value(true));
+    }
+
+    void print_latencies(const std::string& label, std::vector<double> latencies) const
+    {
+        std::sort(latencies.begin(), latencies.end());
+        auto total      = std::accumulate(latencies.begin(), latencies.end(), 0.0);
+        auto average    = latencies.empty() ? 0.0 : total / latencies.size();
+        auto percentile = [&](double x) {
+            return latencies.empty() ? 0.0 : latencies[std::size_t(x * (latencies.size() - 1))];
+        };
+        std::cout << label << ": throughput "
+                  << (average > 0 ? c.l.batch * 1000.0 / average : 0.0)
+                  << " samples/sec, latency average " << average << "ms, p50 " << percentile(0.5)
+                  << "ms, p99 " << percentile(0.99) << "ms" << std::endl;
+    }
+
+    // Times the iterations rotating through the input sets, after a run with each set that
+    // reports the checksums of the outputs
+    void run_input_sets(program& p, const std::vector<parameter_map>& sets)
+    {
+        auto t    = c.ct.get_target();
+        auto& ctx = p.get_context();
+        for(std::size_t i = 0; i < sets.size(); i++)
+        {
+            auto outputs = p.eval(sets[i]);
+            ctx.finish();
+            std::vector<std::string> checksums;
+            std::transform(outputs.begin(),
+                           outputs.end(),
+                           std::back_inserter(checksums),
+                           [&](const auto& output) {
+                               return checksum(c.offload_copy ? output : t.copy_from(output));
+                           });
+            std::cout << "Input set " << i << " output checksums: " << join_strings(checksums, " ")
+                      << std::endl;
+        }
+        std::vector<double> latencies(n);
+        for(std::size_t i = 0; i < latencies.size(); i++)
+        {
+            const auto& m = sets[i % sets.size()];
+            if(cold_cache)
+                flush_cache();
+            latencies[i] = time<std::chrono::duration<double, std::milli>>([&] {
+                p.eval(m);
+                ctx.finish();
+            });
+        }
+        print_latencies(std::to_string(sets.size()) + " input sets" +
+                            (cold_cache ? " with cold caches" : ""),
+                        latencies);
+    }
+
+    void run_numa_policies()
+    {
+        for(auto&& policy : numa_policies)
+        {
+            c.context = {{"numa_policy", policy}};
+            std::cout << "Compiling with numa policy " << policy << " ... " << std::endl;
+            auto p = c.compile();
+            auto m = c.params(p);
+            // Warm up
+            p.eval(m);
+            std::vector<double> latencies(n);
+            std::generate(latencies.begin(), latencies.end(), [&] {
+                return time<std::chrono::duration<double, std::milli>>([&] { p.eval(m); });
+            });
+            print_latencies("Numa policy " + policy, latencies);
+        }
     }
 
     void run()
     {
+        if(not numa_policies.empty())
+        {
+            run_numa_policies();
+            return;
+        }
         std::cout << "Compiling ... " << std::endl;
         auto p = c.compile();
         std::cout << "Allocating params ... " << std::endl;
-        auto m = c.params(p);
+        auto sets = c.param_sets(p);
+        if(sets.size() > 1 or cold_cache or not c.parameters.input_dir.empty())
+        {
+            std::cout << "Running " << n << " iterations over the input sets ... " << std::endl;
+            run_input_sets(p, sets);
+            return;
+        }
         std::cout << "Running performance report ... " << std::endl;
-        p.perf_report(std::cout, n, m, c.l.batch);
+        p.perf_report(std::cout, n, sets.front(), c.l.batch);
+    }
+};
+
+struct batcher : command<batcher>
+{
+    compiler c;
+    std::vector<std::string> batch_sizes;
+    unsigned n         = 1000;
+    double rate        = 1000;
+    unsigned max_batch = 0;
+    unsigned max_delay = 1000;
+    void parse(argument_parser& ap)
+    {
+        c.parse(ap);
+        ap(batch_sizes,
+           {"--buckets"},
+           ap.help("Batch sizes to compile (format: \"b1 b2 bn\")"),
+           ap.append(),
+           ap.nargs(2));
+        ap(n, {"--requests", "-n"}, ap.help("Number of requests to submit"));
+        ap(rate, {"--rate"}, ap.help("Average number of requests arriving per second"));
+        ap(max_batch, {"--max-batch"}, ap.help("Max number of samples evaluated together"));
+        ap(max_delay,
+           {"--max-delay"},
+           ap.help("Max time in microseconds a request waits for more requests"));
+    }
+
+    static parameter_map create_request(const program& p, std::size_t batch_size)
+    {
+        parameter_map m;
+        for(auto&& x : p.get_parameter_shapes())
+        {
+            auto lens = x.second.lens();
+            if(not lens.empty() and lens.front() == batch_size)
+                lens.front() = 1;
+            m[x.first] = generate_argument(shape{x.second.type(), lens},
+                                           std::hash<std::string>{}(x.first));
+        }
+        return m;
+    }
+
+    void run()
+    {
+        using clock = std::chrono::steady_clock;
+        if(batch_sizes.empty())
+            batch_sizes = {"1", std::to_string(c.l.batch)};
+        // Requests are batched on the host
+        c.offload_copy = true;
+        program_buckets buckets;
+        for(auto&& b : batch_sizes)
+        {
+            auto batch_size = value_parser<unsigned>::apply(b);
+            std::cout << "Compiling batch " << batch_size << " ... " << std::endl;
+            c.l.batch = batch_size;
+            buckets.insert(batch_size, c.compile());
+        }
+        auto smallest = buckets.get_batch_sizes().front();
+        auto request  = create_request(buckets.get(smallest), smallest);
+
+        request_batcher_options options;
+        options.max_batch_size = max_batch;
+        options.max_delay      = std::chrono::microseconds{max_delay};
+        request_batcher rb{std::move(buckets), options};
+
+        std::cout << "Submitting " << n << " requests at " << rate << " requests/sec ... "
+                  << std::endl;
+        std::vector<std::future<std::vector<argument>>> results(n);
+        std::vector<clock::time_point> submitted(n);
+        std::vector<double> latencies(n);
+        std::mutex m;
+        std::condition_variable cv;
+        std::size_t count = 0;
+        // Requests complete in the order they are submitted, so the latencies can be collected
+        // in order on another thread
+        joinable_thread collector{[&] {
+            for(std::size_t i = 0; i < n; i++)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m);
+                    cv.wait(lock, [&] { return count > i; });
+                }
+                results[i].wait();
+                latencies[i] =
+                    std::chrono::duration<double, std::milli>(clock::now() - submitted[i]).count();
+            }
+        }};
+
+        std::mt19937 gen{0};
+        std::exponential_distribution<double> arrival{rate};
+        auto next = clock::now();
+        for(std::size_t i = 0; i < n; i++)
+        {
+            next += std::chrono::duration_cast<clock::duration>(
+                std::chrono::duration<double>{arrival(gen)});
+            std::this_thread::sleep_until(next);
+            {
+                std::lock_guard<std::mutex> lock(m);
+                submitted[i] = clock::now();
+                results[i]   = rb.submit(request);
+                count++;
+            }
+            cv.notify_one();
+        }
+        collector.join();
+
+        auto stats = rb.get_stats();
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&](double x) {
+            return latencies.empty() ? 0.0 : latencies[std::size_t(x * (latencies.size() - 1))];
+        };
+        std::cout << "Batches: " << stats.batches << std::endl;
+        std::cout << "Average batch size: " << stats.average_batch_size() << std::endl;
+        std::cout << "Padded samples: " << stats.padded_samples - stats.samples << std::endl;
+        std::cout << "Throughput: " << stats.throughput() << " samples/sec" << std::endl;
+        std::cout << "Average queue time: " << stats.total_queue_time / stats.requests << "ms"
+                  << std::endl;
+        std::cout << "Latency: average " << stats.average_latency() << "ms, p50 "
+                  << percentile(0.5) << "ms, p90 " << percentile(0.9) << "ms, p99 "
+                  << percentile(0.99) << "ms, max " << percentile(1) << "ms" << std::endl;
     }
 };
 
@@ -502,6 +812,37 @@ struct roctx : command<roctx>
     }
 };
 
+struct counters : command<counters>
+{
+    compiler c;
+    unsigned n  = 10;
+    double mpki = 10;
+    void parse(argument_parser& ap)
+    {
+        c.parse(ap);
+        ap(n, {"--iterations", "-n"}, ap.help("Number of runs to aggregate the counters over"));
+        ap(mpki,
+           {"--mpki"},
+           ap.help("Cache misses per thousand instructions above which an op is memory-bound"));
+    }
+
+    void run()
+    {
+        std::cout << "Compiling ... " << std::endl;
+        auto p = c.compile();
+        std::cout << "Allocating params ... " << std::endl;
+        auto m = c.params(p);
+        // Run once so the worker threads of the target exist when the counters are opened
+        p.eval(m);
+        std::cout << "Reading hardware counters ... " << std::endl;
+        auto results = std::make_shared<perf_counter_map>();
+        auto marker  = create_marker_perf(results);
+        for(unsigned i = 0; i < n; i++)
+            p.mark(m, migraphx::marker{marker});
+        print_roofline(std::cout, *results, mpki);
+    }
+};
+
 struct op : command<op>
 {
     bool show_ops = false;
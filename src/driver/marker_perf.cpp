@@ -0,0 +1,222 @@
+#include "marker_perf.hpp"
+
+#include <migraphx/errors.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/instruction_ref.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/time.hpp>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <iomanip>
+#include <map>
+#include <vector>
+
+namespace migraphx {
+namespace driver {
+inline namespace MIGRAPHX_INLINE_NS {
+
+perf_counters& perf_counters::operator+=(const perf_counters& x)
+{
+    time += x.time;
+    cycles += x.cycles;
+    instructions += x.instructions;
+    cache_misses += x.cache_misses;
+    cache_refs += x.cache_refs;
+    runs += x.runs;
+    return *this;
+}
+
+using counter_values = std::array<std::uint64_t, 4>;
+
+static const std::array<std::uint64_t, 4>& counter_events()
+{
+    static const std::array<std::uint64_t, 4> events = {PERF_COUNT_HW_CPU_CYCLES,
+                                                        PERF_COUNT_HW_INSTRUCTIONS,
+                                                        PERF_COUNT_HW_CACHE_MISSES,
+                                                        PERF_COUNT_HW_CACHE_REFERENCES};
+    return events;
+}
+
+static int open_event(std::uint64_t config, pid_t tid)
+{
+    perf_event_attr attr{};
+    attr.size   = sizeof(attr);
+    attr.type   = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    // Counting only user space does not need any privileges on most systems
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, tid, -1, -1, 0));
+}
+
+// The counters of one thread, where a counter the hardware does not support reads as zero
+struct thread_counters
+{
+    std::array<int, 4> fds{};
+
+    explicit thread_counters(pid_t tid)
+    {
+        std::transform(counter_events().begin(),
+                       counter_events().end(),
+                       fds.begin(),
+                       [&](auto event) { return open_event(event, tid); });
+    }
+
+    thread_counters(const thread_counters&) = delete;
+    thread_counters& operator=(const thread_counters&) = delete;
+
+    ~thread_counters()
+    {
+        for(auto fd : fds)
+        {
+            if(fd >= 0)
+                close(fd);
+        }
+    }
+
+    bool valid() const { return fds[0] >= 0 and fds[1] >= 0; }
+
+    void add(counter_values& values) const
+    {
+        for(std::size_t i = 0; i < fds.size(); i++)
+        {
+            std::uint64_t x = 0;
+            if(fds[i] >= 0 and read(fds[i], &x, sizeof(x)) == sizeof(x))
+                values[i] += x;
+        }
+    }
+};
+
+static std::vector<pid_t> get_threads()
+{
+    std::vector<pid_t> result;
+    auto* dir = opendir("/proc/self/task");
+    if(dir == nullptr)
+        return {static_cast<pid_t>(syscall(SYS_gettid))};
+    while(auto* entry = readdir(dir))
+    {
+        if(entry->d_name[0] != '.')
+            result.push_back(std::stoi(entry->d_name));
+    }
+    closedir(dir);
+    return result;
+}
+
+class marker_perf
+{
+    std::shared_ptr<perf_counter_map> counters;
+    std::shared_ptr<std::vector<std::unique_ptr<thread_counters>>> threads;
+    counter_values start_values{};
+    timer start_time{};
+
+    counter_values read_counters() const
+    {
+        counter_values values{};
+        for(const auto& t : *threads)
+            t->add(values);
+        return values;
+    }
+
+    public:
+    marker_perf(std::shared_ptr<perf_counter_map> m)
+        : counters(std::move(m)),
+          threads(std::make_shared<std::vector<std::unique_ptr<thread_counters>>>())
+    {
+    }
+
+    void mark_start(instruction_ref)
+    {
+        start_time   = timer{};
+        start_values = read_counters();
+    }
+    void mark_stop(instruction_ref ins)
+    {
+        auto values = read_counters();
+        perf_counters c;
+        c.time         = start_time.record<std::chrono::duration<double, std::milli>>();
+        c.cycles       = values[0] - start_values[0];
+        c.instructions = values[1] - start_values[1];
+        c.cache_misses = values[2] - start_values[2];
+        c.cache_refs   = values[3] - start_values[3];
+        c.runs         = 1;
+        (*counters)[ins] += c;
+    }
+    // The threads are opened at the first mark, so only the threads that exist by then are
+    // counted and the program should be run once before marking it
+    void mark_start(const program&)
+    {
+        if(not threads->empty())
+            return;
+        for(auto tid : get_threads())
+        {
+            auto t = std::make_unique<thread_counters>(tid);
+            if(t->valid())
+                threads->push_back(std::move(t));
+        }
+        if(threads->empty())
+            MIGRAPHX_THROW("perf_event_open failed: " + std::string(std::strerror(errno)) +
+                           ", check /proc/sys/kernel/perf_event_paranoid");
+    }
+    void mark_stop(const program&) {}
+};
+
+marker create_marker_perf(std::shared_ptr<perf_counter_map> counters)
+{
+    return marker_perf(std::move(counters));
+}
+
+void print_roofline(std::ostream& os, const perf_counter_map& counters, double mpki)
+{
+    std::map<std::string, perf_counters> groups;
+    perf_counters total;
+    std::size_t runs = 0;
+    for(auto&& p : counters)
+    {
+        if(p.first->name() == "@return")
+            continue;
+        groups[perf_group(p.first->get_operator())] += p.second;
+        total += p.second;
+        runs = std::max(runs, p.second.runs);
+    }
+    groups["Total"] = total;
+    runs            = std::max<std::size_t>(runs, 1);
+
+    os << std::left << std::setw(24) << "Group" << std::right << std::setw(12) << "Time(ms)"
+       << std::setw(8) << "Time%" << std::setw(8) << "IPC" << std::setw(10) << "MPKI"
+       << std::setw(12) << "LLC miss%" << std::setw(12) << "GB/s" << std::setw(12) << "Bound"
+       << std::endl;
+    std::vector<std::pair<std::string, perf_counters>> sorted(groups.begin(), groups.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& x, const auto& y) {
+        return x.second.time > y.second.time;
+    });
+    for(auto&& p : sorted)
+    {
+        const auto& c = p.second;
+        auto ratio    = [](double x, double y) { return y > 0 ? x / y : 0.0; };
+        auto m        = ratio(1000.0 * c.cache_misses, c.instructions);
+        // Every miss of the last level cache is a cache line read from memory
+        auto bytes = 64.0 * c.cache_misses;
+        os << std::left << std::setw(24) << p.first << std::right << std::fixed
+           << std::setprecision(3) << std::setw(12) << c.time / runs << std::setprecision(1)
+           << std::setw(8) << ratio(100.0 * c.time, total.time) << std::setprecision(2)
+           << std::setw(8) << ratio(c.instructions, c.cycles) << std::setw(10) << m
+           << std::setprecision(1) << std::setw(12) << ratio(100.0 * c.cache_misses, c.cache_refs)
+           << std::setw(12) << ratio(bytes, c.time * 1.0e6) << std::setw(12)
+           << (m > mpki ? "memory" : "compute") << std::endl;
+        os.unsetf(std::ios::fixed);
+    }
+    os << std::endl;
+    os << "Runs: " << runs << std::endl;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace driver
+} // namespace migraphx
@@ -0,0 +1,48 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_MARKER_PERF_HPP
+#define MIGRAPHX_GUARD_RTGLIB_MARKER_PERF_HPP
+
+#include <migraphx/marker.hpp>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <unordered_map>
+
+namespace migraphx {
+namespace driver {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// Hardware counters of an instruction summed over every run and every thread
+struct perf_counters
+{
+    double time                = 0;
+    std::uint64_t cycles       = 0;
+    std::uint64_t instructions = 0;
+    std::uint64_t cache_misses = 0;
+    std::uint64_t cache_refs   = 0;
+    std::size_t runs           = 0;
+    perf_counters& operator+=(const perf_counters& x);
+};
+
+using perf_counter_map = std::unordered_map<instruction_ref, perf_counters>;
+
+/**
+ * Creates a marker that reads the hardware counters of every thread of the process with
+ * `perf_event_open` around each instruction. The counters are added to the map, so it can be
+ * passed to several calls of `program::mark` to aggregate the counters over the runs. The
+ * threads are found when the program is first marked, so threads that the target starts during
+ * its first run are only counted if the program was run before.
+ */
+marker create_marker_perf(std::shared_ptr<perf_counter_map> counters);
+
+/**
+ * Prints the counters grouped by `perf_group`, with the bandwidth estimated from the last level
+ * cache misses. A group with more misses per thousand instructions than `mpki` is reported as
+ * memory-bound, and as compute-bound otherwise.
+ */
+void print_roofline(std::ostream& os, const perf_counter_map& counters, double mpki);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace driver
+} // namespace migraphx
+
+#endif
@@ -2,6 +2,7 @@
 
 #include <migraphx/generate.hpp>
 #include <migraphx/register_target.hpp>
+#include <sys/resource.h>
 #ifdef HAVE_GPU
 #include <migraphx/gpu/hip.hpp>
 #endif
@@ -87,6 +88,15 @@ target get_target(bool gpu)
 
 void compile_program(program& p, bool gpu) { p.compile(get_target(gpu)); }
 
+std::size_t get_peak_memory()
+{
+    rusage usage{};
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    // ru_maxrss is in kilobytes
+    return usage.ru_maxrss * std::size_t{1024};
+}
+
 } // namespace  MIGRAPHX_INLINE_NS
 } // namespace driver
 } // namespace migraphx
@@ -16,6 +16,9 @@ parameter_map create_param_map(const program& p, bool gpu = true);
 target get_target(bool gpu);
 void compile_program(program& p, bool gpu = true);
 
+// Peak resident memory of the process in bytes
+std::size_t get_peak_memory();
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace driver
 } // namespace migraphx
@@ -30,56 +30,99 @@ void eliminate_concat::apply(module& m) const
                       arg->outputs().size() > 1;
            }))
             continue;
-        // We can only do this optimization when concat axis is either the leftmost
-        // axis OR the sizes to the left of this axis are all equal to 1
+        // Without strided outputs we can only do this optimization when concat axis is either the
+        // leftmost axis OR the sizes to the left of this axis are all equal to 1, so each input is
+        // a contiguous chunk of the output
         // Since we've already checked that the non-axis dimensions are identical
         // we only need to check the first input
         auto lens              = ins->inputs().front()->get_shape().lens();
         auto concat_op         = concat_opt.get_concat(ins->get_operator());
         std::size_t axis_index = tune_axis(lens.size(), concat_op.axis, concat_op.name());
-        if(axis_index == 0 ||
-           std::all_of(lens.begin(), lens.begin() + axis_index, [](auto x) { return x == 1; }))
-        {
-            // Last input should be an allocation
-            auto last = ins->inputs().back();
-            if(last->name() != concat_opt.allocate())
-                continue;
-            // Where are the allocations for the tensors to be concatenated?
-            std::vector<instruction_ref> allocations;
+        bool contiguous =
+            axis_index == 0 ||
+            std::all_of(lens.begin(), lens.begin() + axis_index, [](auto x) { return x == 1; });
+        if(not contiguous and not concat_opt.supports_strided())
+            continue;
+        // Last input should be an allocation
+        auto last = ins->inputs().back();
+        if(last->name() != concat_opt.allocate())
+            continue;
+        // Where are the allocations for the tensors to be concatenated?
+        std::vector<instruction_ref> allocations;
 
-            std::transform(
-                ins->inputs().begin(),
-                std::prev(ins->inputs().end()),
-                std::back_inserter(allocations),
-                [&](instruction_ref x) { return instruction::get_output_alias(x, true); });
+        std::transform(ins->inputs().begin(),
+                       std::prev(ins->inputs().end()),
+                       std::back_inserter(allocations),
+                       [&](instruction_ref x) { return instruction::get_output_alias(x, true); });
 
-            if(std::any_of(allocations.begin(), allocations.end(), [&](auto x) {
-                   return x->name() != concat_opt.allocate();
-               }))
-                continue;
+        if(std::any_of(allocations.begin(), allocations.end(), [&](auto x) {
+               return x->name() != concat_opt.allocate();
+           }))
+            continue;
 
-            // Need to sort the allocations, so that we know where to
-            // insert the "super"-allocation
-            auto sorted_allocations = allocations;
-            std::sort(sorted_allocations.begin(),
-                      sorted_allocations.end(),
-                      [&](instruction_ref x, instruction_ref y) {
-                          return std::distance(m.begin(), x) < std::distance(m.begin(), y);
-                      });
-            // Move "super" allocation to the front
-            auto first = sorted_allocations.front();
-            auto super = m.move_instruction(last, first);
-            // Replace each allocation with a load
-            std::size_t offset = 0;
-            for(auto alloc : allocations)
+        // Each input is written to a slice of the output, at the offset of the input along the
+        // axis and with the strides of the output
+        std::vector<shape> slices;
+        std::vector<std::size_t> offsets;
+        std::size_t offset = 0;
+        for(auto alloc : allocations)
+        {
+            const auto& s = alloc->get_shape();
+            if(contiguous)
             {
-                op::load op{alloc->get_shape(), offset};
-                m.replace_instruction(alloc, op, {super});
-                offset += alloc->get_shape().bytes();
+                slices.push_back(s);
+                offsets.push_back(offset);
+                offset += s.bytes();
             }
-            std::vector<instruction_ref> args = {super};
-            std::copy(ins->inputs().begin(), ins->inputs().end() - 1, std::back_inserter(args));
-            m.replace_instruction(ins, migraphx::make_op("identity"), args);
+            else
+            {
+                const auto& strides = last->get_shape().strides();
+                slices.push_back(shape{s.type(), s.lens(), strides});
+                offsets.push_back(offset * strides[axis_index] * s.type_size());
+                offset += s.lens()[axis_index];
+            }
+        }
+
+        // The operators have to write to the strided slices, and since the allocations of nested
+        // concats are shared with loads they cannot be strided
+        auto writes_to_slice = [&](std::ptrdiff_t i) {
+            auto x     = ins->inputs()[i];
+            auto alloc = allocations[i];
+            if(alloc->outputs().size() != 1)
+                return false;
+            std::vector<shape> inputs;
+            std::transform(x->inputs().begin(),
+                           x->inputs().end(),
+                           std::back_inserter(inputs),
+                           [&](instruction_ref input) {
+                               return input == alloc ? slices[i] : input->get_shape();
+                           });
+            auto output = try_compute_shape(x->get_operator(), inputs);
+            return not output.empty() and output.front() == slices[i];
+        };
+        if(not contiguous and not all_of(range(allocations.size()), writes_to_slice))
+            continue;
+
+        // Need to sort the allocations, so that we know where to
+        // insert the "super"-allocation
+        auto sorted_allocations = allocations;
+        std::sort(sorted_allocations.begin(),
+                  sorted_allocations.end(),
+                  [&](instruction_ref x, instruction_ref y) {
+                      return std::distance(m.begin(), x) < std::distance(m.begin(), y);
+                  });
+        // Move "super" allocation to the front
+        auto first = sorted_allocations.front();
+        auto super = m.move_instruction(last, first);
+        // Replace the concat first, since it might not accept the strided inputs
+        std::vector<instruction_ref> args = {super};
+        std::copy(ins->inputs().begin(), ins->inputs().end() - 1, std::back_inserter(args));
+        m.replace_instruction(ins, migraphx::make_op("identity"), args);
+        // Replace each allocation with a load
+        for(std::size_t i = 0; i < allocations.size(); i++)
+        {
+            op::load op{slices[i], offsets[i]};
+            m.replace_instruction(allocations[i], op, {super});
         }
     }
 }
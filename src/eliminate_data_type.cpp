@@ -11,6 +11,7 @@ inline namespace MIGRAPHX_INLINE_NS {
 void eliminate_data_type::apply(module& m) const
 {
     static const std::vector<std::string> skip_op_names = {"convert",
+                                                           "dequant_dot",
                                                            "get_tuple_elem",
                                                            "if",
                                                            "loop",
@@ -7,23 +7,30 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
 template <class T>
-T generic_read_file(const std::string& filename)
+T generic_read_file(const std::string& filename, std::size_t offset = 0, std::size_t nbytes = 0)
 {
     std::ifstream is(filename, std::ios::binary | std::ios::ate);
     std::streamsize size = is.tellg();
     if(size < 1)
         MIGRAPHX_THROW("Invalid size for: " + filename);
-    is.seekg(0, std::ios::beg);
+    auto file_size = static_cast<std::size_t>(size);
+    if(offset >= file_size)
+        MIGRAPHX_THROW("Invalid offset " + std::to_string(offset) + " for: " + filename);
+    if(nbytes == 0)
+        nbytes = file_size - offset;
+    else if(nbytes > file_size - offset)
+        MIGRAPHX_THROW("Not enough data in: " + filename);
+    is.seekg(offset, std::ios::beg);
 
-    T buffer(size, 0);
-    if(!is.read(&buffer[0], size))
+    T buffer(nbytes, 0);
+    if(!is.read(&buffer[0], nbytes))
         MIGRAPHX_THROW("Error reading file: " + filename);
     return buffer;
 }
 
-std::vector<char> read_buffer(const std::string& filename)
+std::vector<char> read_buffer(const std::string& filename, std::size_t offset, std::size_t nbytes)
 {
-    return generic_read_file<std::vector<char>>(filename);
+    return generic_read_file<std::vector<char>>(filename, offset, nbytes);
 }
 
 std::string read_string(const std::string& filename)
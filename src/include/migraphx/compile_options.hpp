@@ -3,15 +3,23 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/tracer.hpp>
+#include <migraphx/value.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+struct compile_profile;
+
 struct compile_options
 {
     bool offload_copy = false;
     bool fast_math    = true;
     tracer trace{};
+    /// Records the time and the effect of each pass when it is set
+    compile_profile* profile = nullptr;
+    /// Settings of the context of the target, which are set before the passes run, such as the
+    /// numa_policy of the cpu target
+    value context = {};
 };
 
 } // namespace MIGRAPHX_INLINE_NS
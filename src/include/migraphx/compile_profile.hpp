@@ -0,0 +1,92 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_COMPILE_PROFILE_HPP
+#define MIGRAPHX_GUARD_RTGLIB_COMPILE_PROFILE_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/value.hpp>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct module;
+struct program;
+
+/**
+ * Records what each pass of a compilation does to each module: the time it takes, the number of
+ * instructions before and after, and the bytes of the literals and of the scratch memory
+ * allocated after it. Passes applied to the whole program are recorded without a module when
+ * they change it, and the finalization of each module is recorded as a `finalize` pass.
+ */
+struct compile_profile
+{
+    struct pass_record
+    {
+        std::string pass;
+        std::string module;
+        // Milliseconds since the start of the compilation
+        double start_ms                 = 0;
+        double time_ms                  = 0;
+        std::size_t instructions_before = 0;
+        std::size_t instructions_after  = 0;
+        std::size_t literal_bytes       = 0;
+        std::size_t scratch_bytes       = 0;
+    };
+
+    std::string target;
+    std::vector<pass_record> records;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    struct totals
+    {
+        std::size_t instructions  = 0;
+        std::size_t literal_bytes = 0;
+        std::size_t scratch_bytes = 0;
+    };
+
+    static totals get_totals(const module& m);
+    static totals get_totals(const program& p);
+
+    // Runs f, which applies the pass to the module or to the program, and records it
+    template <class T, class F>
+    void run(const std::string& pass, const std::string& module_name, const T& x, F f)
+    {
+        auto before = get_totals(x);
+        auto begin  = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        add(pass, module_name, before, get_totals(x), ms(begin - start), ms(end - begin));
+    }
+
+    void add(const std::string& pass,
+             const std::string& module_name,
+             const totals& before,
+             const totals& after,
+             double start_ms,
+             double time_ms);
+
+    double total_ms() const;
+
+    /// The records and the time of each pass summed over the modules, as JSON
+    value to_value() const;
+    /// The records as complete events of the Chrome trace event format
+    value to_chrome_trace() const;
+    /// Prints the passes that take the most time
+    void print_summary(std::ostream& os, std::size_t n = 10) const;
+    /// Writes the JSON of `to_value` or of `to_chrome_trace` to the file
+    void write(const std::string& filename, bool chrome_trace = false) const;
+
+    private:
+    template <class Duration>
+    static double ms(Duration d)
+    {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
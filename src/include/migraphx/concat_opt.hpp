@@ -26,10 +26,23 @@ struct concat_optimization
     std::string allocate() const;
     /// Return the target-independent concat operator
     op::concat get_concat(const operation& op) const;
+    /// Whether the operators can write to a strided slice of the allocation, which is needed to
+    /// concat along an axis that has a dimension greater than one before it
+    bool supports_strided() const;
 };
 
 #else
 
+namespace detail {
+
+template <class T>
+bool concat_supports_strided(const T&)
+{
+    return false;
+}
+
+} // namespace detail
+
 #ifdef TYPE_ERASED_DECLARATION
 
 // Type-erased interface for:
@@ -41,6 +54,8 @@ struct concat_optimization
     std::string allocate() const;
     //
     op::concat get_concat(const operation& op) const;
+    // (optional)
+    bool supports_strided() const;
 };
 
 #else
@@ -126,6 +141,12 @@ struct concat_optimization
         return (*this).private_detail_te_get_handle().get_concat(op);
     }
 
+    bool supports_strided() const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        return (*this).private_detail_te_get_handle().supports_strided();
+    }
+
     friend bool is_shared(const concat_optimization& private_detail_x,
                           const concat_optimization& private_detail_y)
     {
@@ -143,8 +164,22 @@ struct concat_optimization
         virtual std::string name() const                         = 0;
         virtual std::string allocate() const                     = 0;
         virtual op::concat get_concat(const operation& op) const = 0;
+        virtual bool supports_strided() const                    = 0;
     };
 
+    template <class T>
+    static auto private_detail_te_default_supports_strided(char, T&& private_detail_te_self)
+        -> decltype(private_detail_te_self.supports_strided())
+    {
+        return private_detail_te_self.supports_strided();
+    }
+
+    template <class T>
+    static bool private_detail_te_default_supports_strided(float, T&& private_detail_te_self)
+    {
+        return migraphx::detail::concat_supports_strided(private_detail_te_self);
+    }
+
     template <typename PrivateDetailTypeErasedT>
     struct private_detail_te_handle_type : private_detail_te_handle_base_type
     {
@@ -183,6 +218,12 @@ struct concat_optimization
             return private_detail_te_value.get_concat(op);
         }
 
+        bool supports_strided() const override
+        {
+
+            return private_detail_te_default_supports_strided(char(0), private_detail_te_value);
+        }
+
         PrivateDetailTypeErasedT private_detail_te_value;
     };
 
@@ -0,0 +1,60 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_COST_MODEL_HPP
+#define MIGRAPHX_GUARD_RTGLIB_COST_MODEL_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/instruction_ref.hpp>
+#include <istream>
+#include <string>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// The work of an instruction estimated from the shapes of its inputs and output
+struct instruction_cost
+{
+    double flops = 0;
+    double bytes = 0;
+};
+
+instruction_cost estimate_cost(instruction_ref ins);
+
+/// A key that identifies an instruction by its operator and its output shape, as printed by
+/// `program::perf_report`, so the times measured in one run can be found in a later compile
+std::string cost_key(instruction_ref ins);
+
+/// Reads the average time in milliseconds of each instruction of a perf report, by `cost_key`
+std::unordered_map<std::string, double> read_perf_report(std::istream& is);
+std::unordered_map<std::string, double> read_perf_report(const std::string& filename);
+
+/**
+ * Computes the weights of the instructions for the scheduler from a time in microseconds. The
+ * time measured by a previous perf report is used when the instruction is found in `times`,
+ * otherwise it is estimated with a roofline: the larger of the time spent on the floating-point
+ * operations at the peak `flops`, and the time spent moving the bytes at the peak `bandwidth`.
+ */
+struct cost_model
+{
+    /// Floating-point operations per second
+    double flops = 0;
+    /// Bytes per second
+    double bandwidth = 0;
+    /// Times in milliseconds by `cost_key`
+    std::unordered_map<std::string, double> times = {};
+    /// Branches that take at most this time in microseconds are not given a stream of their own,
+    /// as it is about the cost of launching a kernel and synchronizing with another stream
+    double partition_time = 10;
+
+    /// Returns true when no cost can be computed, so only the schedule model is used
+    bool empty() const;
+    /// The time of the instruction in microseconds
+    double time(instruction_ref ins) const;
+    std::size_t weight(instruction_ref ins) const;
+    /// The largest weight of a branch that is kept on the stream of the instruction using it
+    std::size_t partition_threshold() const;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -8,7 +8,9 @@
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
-std::vector<char> read_buffer(const std::string& filename);
+/// Read nbytes starting at offset from the file, or up to the end of the file when nbytes is 0
+std::vector<char>
+read_buffer(const std::string& filename, std::size_t offset = 0, std::size_t nbytes = 0);
 std::string read_string(const std::string& filename);
 
 void write_buffer(const std::string& filename, const char* buffer, std::size_t size);
@@ -58,12 +58,19 @@ struct literal : raw_data<literal>
         std::copy(x, x + s.bytes(), buffer.get());
     }
 
+    /// Use the buffer for the data without copying it, so it must hold at least s.bytes() bytes
+    literal(const shape& s, std::shared_ptr<char> b) : buffer(std::move(b)), m_shape(s) {}
+
     /// Whether data is available
     bool empty() const { return this->buffer == nullptr; }
 
     /// Provides a raw pointer to the data
     const char* data() const { return this->buffer.get(); }
 
+    /// The buffer of the data, which is shared with the copies of the literal, so it must not be
+    /// modified
+    std::shared_ptr<char> get_buffer() const { return this->buffer; }
+
     const shape& get_shape() const { return this->m_shape; }
 
     std::vector<literal> get_sub_objects() const { return {}; }
@@ -75,6 +82,10 @@ struct literal : raw_data<literal>
         return {m_shape, [b]() { return b.get(); }};
     }
 
+    /// Convert to an argument that shares the data instead of copying it, so it must not be
+    /// modified through the argument
+    argument share_argument() const { return {m_shape, buffer}; }
+
     private:
     std::shared_ptr<char> buffer;
     shape m_shape;
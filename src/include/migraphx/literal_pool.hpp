@@ -0,0 +1,52 @@
+#ifndef MIGRAPHX_GUARD_MIGRAPHLIB_LITERAL_POOL_HPP
+#define MIGRAPHX_GUARD_MIGRAPHLIB_LITERAL_POOL_HPP
+
+#include <migraphx/literal.hpp>
+#include <migraphx/config.hpp>
+#include <iosfwd>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct literal_pool_stats
+{
+    /// Number of literals looked up in the pool
+    std::size_t lookups = 0;
+    /// Number of lookups that found an identical buffer from another literal
+    std::size_t hits = 0;
+    /// Total size of the literals that were replaced by a buffer from the pool
+    std::size_t bytes_saved = 0;
+    /// Number of buffers in the pool
+    std::size_t buffers = 0;
+    /// Total size of the buffers in the pool
+    std::size_t bytes = 0;
+
+    friend std::ostream& operator<<(std::ostream& os, const literal_pool_stats& x);
+};
+
+/**
+ * @brief Deduplicates the literals of a group of programs
+ *
+ * The pool keeps the buffer of every literal added to it, keyed by its size and a hash of its
+ * bytes. When a literal has the same bytes as a buffer already in the pool, a literal with the
+ * same shape that shares that buffer is returned, otherwise the literal itself is returned and its
+ * buffer is added to the pool. The pool is not thread-safe and is meant to be scoped to the
+ * programs being deduplicated, such as in `program_buckets::share_literals`. The buffers are
+ * shared without copying, so they must not be written to once they are in the pool.
+ */
+struct literal_pool
+{
+    literal add(const literal& l);
+
+    literal_pool_stats get_stats() const;
+
+    private:
+    std::unordered_multimap<std::size_t, literal> entries;
+    literal_pool_stats stats;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef MIGRAPHX_GUARD_MATCH_ATTENTION_HPP
+#define MIGRAPHX_GUARD_MATCH_ATTENTION_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/matcher.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace match {
+
+/**
+ * Returns the instructions computing the attention scores, `dot(q, k) * scale + mask`, starting
+ * from the given instruction and ending with the `dot`. The scale is either a `mul` or a `div` by
+ * a constant, and both the scale and the add of the mask are optional. An empty vector is returned
+ * when the instruction does not compute the scores or when the scores are used elsewhere.
+ */
+inline std::vector<instruction_ref> attention_scores_chain(instruction_ref ins)
+{
+    auto is_dot   = [](instruction_ref x) { return x->name() == "dot"; };
+    auto is_scale = [](instruction_ref x) { return contains({"mul", "div"}, x->name()); };
+    auto scaled   = [&](instruction_ref x) {
+        if(is_dot(x))
+            return true;
+        return is_scale(x) and std::any_of(x->inputs().begin(), x->inputs().end(), is_dot);
+    };
+    std::vector<instruction_ref> chain;
+    while(chain.size() < 3)
+    {
+        if(ins->outputs().size() != 1)
+            return {};
+        chain.push_back(ins);
+        const auto& inputs = ins->inputs();
+        if(is_dot(ins))
+            return chain;
+        if(ins->name() == "add" and chain.size() == 1)
+        {
+            if(scaled(inputs[0]) == scaled(inputs[1]))
+                return {};
+            ins = scaled(inputs[0]) ? inputs[0] : inputs[1];
+        }
+        else if(ins->name() == "mul")
+        {
+            if(is_dot(inputs[0]) == is_dot(inputs[1]))
+                return {};
+            auto i = is_dot(inputs[0]) ? 0 : 1;
+            if(not inputs[1 - i]->can_eval())
+                return {};
+            ins = inputs[i];
+        }
+        else if(ins->name() == "div" and is_dot(inputs[0]) and inputs[1]->can_eval())
+        {
+            ins = inputs[0];
+        }
+        else
+        {
+            return {};
+        }
+    }
+    return {};
+}
+
+MIGRAPHX_PRED_MATCHER(attention_scores, instruction_ref ins)
+{
+    return not attention_scores_chain(ins).empty();
+}
+
+namespace detail {
+template <class F>
+struct attention_matcher
+{
+    F f;
+    auto matcher() const
+    {
+        return f("dot")(
+            arg(0)(f("softmax")(used_once(), arg(0)(attention_scores())).bind("softmax")),
+            arg(1)(any().bind("v")));
+    }
+};
+} // namespace detail
+
+/**
+ * Matches scaled dot-product attention, `dot(softmax(dot(q, k) * scale + mask), v)`. It binds the
+ * "softmax" and "v", and `attention_scores_chain` on the input of the softmax gives the rest.
+ */
+template <class F>
+auto attention(F f)
+{
+    return detail::attention_matcher<F>{f}.matcher();
+}
+
+inline auto attention()
+{
+    return attention([](auto x) { return name(x); });
+}
+
+} // namespace match
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MATCH_ATTENTION_HPP
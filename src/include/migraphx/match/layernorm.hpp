@@ -9,13 +9,15 @@ inline namespace MIGRAPHX_INLINE_NS {
 namespace match {
 
 namespace detail {
-template <class F>
+template <class F, class E>
 struct layernorm_matcher
 {
     F f;
+    E epsilon;
     auto x_minus_mean() const
     {
-        return f("sub")(arg(0)(any().bind("x")), arg(1)(skip_broadcasts(f("reduce_mean"))));
+        return f("sub")(arg(0)(any().bind("x")),
+                        arg(1)(skip_broadcasts(f("reduce_mean").bind("mean"))));
     }
 
     auto variance() const
@@ -23,22 +25,33 @@ struct layernorm_matcher
         return f("reduce_mean")(arg(0)(f("pow")(arg(0)(x_minus_mean()), arg(1)(has_value(2.0f)))));
     }
 
+    auto variance_plus_epsilon() const
+    {
+        return f("add")(either_arg(0, 1)(variance(), epsilon.bind("epsilon")));
+    }
+
     auto layernorm_onnx() const
     {
         return f("div")(arg(0)(x_minus_mean()),
 
-                        arg(1)(skip_broadcasts(f("sqrt")(
-                            arg(0)(f("add")(either_arg(0, 1)(variance(), has_value(1e-12f))))))));
+                        arg(1)(skip_broadcasts(f("sqrt")(arg(0)(variance_plus_epsilon())))));
     }
 
     auto matcher() const { return layernorm_onnx(); }
 };
 } // namespace detail
 
+/// Matches layernorm with an epsilon that matches the epsilon matcher, which is bound as "epsilon"
+template <class F, class E>
+auto layernorm(F f, E epsilon)
+{
+    return detail::layernorm_matcher<F, E>{f, epsilon}.matcher();
+}
+
 template <class F>
 auto layernorm(F f)
 {
-    return detail::layernorm_matcher<F>{f}.matcher();
+    return layernorm(f, has_value(1e-12f));
 }
 
 inline auto layernorm()
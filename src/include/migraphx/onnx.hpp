@@ -2,6 +2,7 @@
 #define MIGRAPHX_GUARD_MIGRAPHLIB_ONNX_HPP
 
 #include <migraphx/program.hpp>
+#include <migraphx/program_buckets.hpp>
 #include <migraphx/config.hpp>
 
 namespace migraphx {
@@ -31,6 +32,11 @@ program parse_onnx_buffer(const std::string& buffer, const onnx_options& options
 /// Create a program from an onnx buffer
 program parse_onnx_buffer(const void* data, std::size_t size, const onnx_options& options);
 
+/// Create a program for each batch size from an onnx file, sharing identical literals between them
+program_buckets parse_onnx_buckets(const std::string& name,
+                                   const std::vector<std::size_t>& batch_sizes,
+                                   const onnx_options& = onnx_options{});
+
 std::vector<std::string> get_onnx_operators();
 
 } // namespace MIGRAPHX_INLINE_NS
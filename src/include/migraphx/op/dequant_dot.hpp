@@ -0,0 +1,121 @@
+#ifndef MIGRAPHX_GUARD_OPERATORS_DEQUANT_DOT_HPP
+#define MIGRAPHX_GUARD_OPERATORS_DEQUANT_DOT_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/value.hpp>
+#include <cstdint>
+#include <utility>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Multiplies `a` by a `{k, n}` matrix of weights quantized to 8 or 4 bits, which are dequantized
+ * with a scale for each column and for each group of `group_size` rows, or for the whole column
+ * when the group size is 0. The inputs are `a` with the shape `{..., k}`, the quantized weights
+ * stored transposed, so each column is contiguous, and the scales with the shape `{n, groups}`
+ * and the type of `a`. The 8-bit weights are int8 with the shape `{n, k}`. The 4-bit weights are
+ * signed and packed in pairs into uint8 with the shape `{n, (k + 1) / 2}`, where the low nibble
+ * holds the even row.
+ */
+struct dequant_dot
+{
+    std::size_t bits       = 8;
+    std::size_t group_size = 0;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.bits, "bits"), f(self.group_size, "group_size"));
+    }
+
+    std::string name() const { return "dequant_dot"; }
+
+    std::size_t groups(std::size_t k) const
+    {
+        if(group_size == 0)
+            return 1;
+        return (k + group_size - 1) / group_size;
+    }
+
+    static std::size_t packed_size(std::size_t k, std::size_t nbits)
+    {
+        return nbits == 4 ? (k + 1) / 2 : k;
+    }
+
+    // Returns the signed value of row `k` from a byte of packed 4-bit weights
+    static std::int8_t unpack_int4(std::uint8_t x, std::size_t k)
+    {
+        auto nibble = (k % 2 == 0) ? (x & 0x0f) : (x >> 4);
+        return static_cast<std::int8_t>(nibble >= 8 ? nibble - 16 : nibble);
+    }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(3);
+        const shape& a      = inputs.at(0);
+        const shape& b      = inputs.at(1);
+        const shape& scales = inputs.at(2);
+        if(bits != 8 and bits != 4)
+            MIGRAPHX_THROW("DEQUANT_DOT: only 8 and 4 bits are supported");
+        if(not contains({shape::float_type, shape::half_type, shape::double_type}, a.type()))
+            MIGRAPHX_THROW("DEQUANT_DOT: only floating-point inputs are supported");
+        if(a.lens().empty() or b.lens().size() != 2 or scales.lens().size() != 2)
+            MIGRAPHX_THROW("DEQUANT_DOT: the weights and the scales must be 2 dims");
+        auto wtype = bits == 8 ? shape::int8_type : shape::uint8_type;
+        if(b.type() != wtype)
+            MIGRAPHX_THROW("DEQUANT_DOT: " + std::to_string(bits) + "-bit weights must be " +
+                           shape::cpp_type(wtype));
+        auto k = a.lens().back();
+        auto n = b.lens().front();
+        if(b.lens().back() != packed_size(k, bits))
+            MIGRAPHX_THROW("DEQUANT_DOT: inner dimensions do not match: {" +
+                           to_string_range(a.lens()) + "} x {" + to_string_range(b.lens()) + "}");
+        if(scales.type() != a.type() or scales.lens() != std::vector<std::size_t>{n, groups(k)})
+            MIGRAPHX_THROW("DEQUANT_DOT: scales must be {" + std::to_string(n) + ", " +
+                           std::to_string(groups(k)) + "} of the input type");
+        auto out_lens   = a.lens();
+        out_lens.back() = n;
+        return {a.type(), out_lens};
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        argument result{output_shape};
+        auto k      = args[0].get_shape().lens().back();
+        auto n      = output_shape.lens().back();
+        auto kp     = packed_size(k, bits);
+        auto group  = group_size == 0 ? k : group_size;
+        auto ngroup = groups(k);
+        visit_all(result, args[0], args[2])([&](auto output, auto a, auto scales) {
+            args[1].visit([&](auto b) {
+                par_for(output_shape.elements(), [&](auto i) {
+                    auto row   = i / n;
+                    auto col   = i % n;
+                    double acc = 0;
+                    for(std::size_t j = 0; j < k; j++)
+                    {
+                        double w     = (bits == 4) ? unpack_int4(b[col * kp + j / 2], j)
+                                                   : static_cast<double>(b[col * kp + j]);
+                        double scale = scales[col * ngroup + j / group];
+                        acc += static_cast<double>(a[row * k + j]) * w * scale;
+                    }
+                    output[i] = acc;
+                });
+            });
+        });
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -9,6 +9,9 @@
 #include <migraphx/config.hpp>
 #include <migraphx/value.hpp>
 #include <migraphx/op/normalize_attribute.hpp>
+#include <algorithm>
+#include <array>
+#include <thread>
 #include <vector>
 
 namespace migraphx {
@@ -127,6 +130,154 @@ struct reduce_op : op_name<Derived>
             static_cast<const Derived&>(*this).output(batch_shape)(val);
     }
 
+    // Collapses the input into `[outer, reduce, inner]`, which is possible when the reduced axes
+    // are next to each other once the dimensions of length 1 are skipped
+    static bool collapse_dims(const std::vector<std::size_t>& lens,
+                              const std::vector<int64_t>& tuned_axes,
+                              std::array<std::size_t, 3>& dims)
+    {
+        dims              = {1, 1, 1};
+        std::size_t block = 0;
+        for(std::size_t i = 0; i < lens.size(); i++)
+        {
+            if(lens[i] == 1)
+                continue;
+            bool reduced = std::find(tuned_axes.begin(), tuned_axes.end(), std::int64_t(i)) !=
+                           tuned_axes.end();
+            if(reduced and block == 2)
+                return false;
+            if(reduced)
+                block = 1;
+            else if(block == 1)
+                block = 2;
+            dims[block] *= lens[i];
+        }
+        return true;
+    }
+
+    // Reduces n contiguous elements by splitting them in halves, so the rounding error grows with
+    // the log of n, and with independent accumulators at the bottom so the loop is vectorized
+    template <class Accumulator, class T>
+    Accumulator reduce_pairwise(const T* x, std::size_t n) const
+    {
+        constexpr std::size_t block = 128;
+        constexpr std::size_t lanes = 8;
+        auto& self                  = static_cast<const Derived&>(*this);
+        if(n > block)
+        {
+            auto half = n / 2;
+            return self.op()(this->reduce_pairwise<Accumulator>(x, half),
+                             this->reduce_pairwise<Accumulator>(x + half, n - half));
+        }
+        auto f = self.op();
+        auto g = self.input();
+        std::array<Accumulator, lanes> acc;
+        acc.fill(self.init());
+        std::size_t i = 0;
+        for(; i + lanes <= n; i += lanes)
+        {
+            for(std::size_t j = 0; j < lanes; j++)
+                acc[j] = f(Accumulator{g(Accumulator{x[i + j]})}, acc[j]);
+        }
+        for(; i < n; i++)
+            acc[0] = f(Accumulator{g(Accumulator{x[i]})}, acc[0]);
+        Accumulator val = self.init();
+        for(auto a : acc)
+            val = f(a, val);
+        return val;
+    }
+
+    // Reduces the rows [r0, r1) of a `[reduce, inner]` slice of the input into the accumulators of
+    // the columns [i0, i1). The rows are added to a block first, so the sums stay accurate.
+    template <class Accumulator, class T>
+    void reduce_rows(const T* x,
+                     std::size_t r0,
+                     std::size_t r1,
+                     std::size_t inner,
+                     std::size_t i0,
+                     std::size_t i1,
+                     Accumulator* acc) const
+    {
+        auto& self = static_cast<const Derived&>(*this);
+        auto f     = self.op();
+        if(inner == 1)
+        {
+            acc[0] = f(this->reduce_pairwise<Accumulator>(x + r0, r1 - r0), acc[0]);
+            return;
+        }
+        constexpr std::size_t block = 64;
+        auto g                      = self.input();
+        std::vector<Accumulator> partial(i1 - i0);
+        for(auto b = r0; b < r1; b += block)
+        {
+            std::fill(partial.begin(), partial.end(), Accumulator(self.init()));
+            for(auto r = b; r < std::min(r1, b + block); r++)
+            {
+                const T* row = x + r * inner + i0;
+                for(std::size_t i = 0; i < partial.size(); i++)
+                    partial[i] = f(Accumulator{g(Accumulator{row[i]})}, partial[i]);
+            }
+            for(std::size_t i = 0; i < partial.size(); i++)
+                acc[i] = f(partial[i], acc[i]);
+        }
+    }
+
+    // Reduces a standard input collapsed to `[outer, reduce, inner]`. The work is split over the
+    // outputs when there are more outputs than reduced elements, and over blocks of the reduced
+    // elements otherwise, whose partial results are combined at the end.
+    template <class T, class U>
+    void reduce_collapsed(const T* input,
+                          U* output,
+                          const std::array<std::size_t, 3>& dims,
+                          const shape& batch_shape) const
+    {
+        using accumulator = accumulator_type<T>;
+        auto& self        = static_cast<const Derived&>(*this);
+        auto outer        = dims[0];
+        auto n            = dims[1];
+        auto inner        = dims[2];
+        auto outputs      = outer * inner;
+        auto out          = self.output(batch_shape);
+        if(outputs >= n)
+        {
+            constexpr std::size_t tile = 256;
+            auto tiles                 = (inner + tile - 1) / tile;
+            par_for(outer * tiles, [&](auto i) {
+                auto o  = i / tiles;
+                auto i0 = (i % tiles) * tile;
+                auto i1 = std::min(inner, i0 + tile);
+                std::vector<accumulator> acc(i1 - i0, accumulator(self.init()));
+                this->reduce_rows(input + o * n * inner, 0, n, inner, i0, i1, acc.data());
+                for(auto j = i0; j < i1; j++)
+                    output[o * inner + j] = out(acc[j - i0]);
+            });
+            return;
+        }
+        constexpr std::size_t min_chunk = 4096;
+        auto chunks = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u),
+                                            (n * inner + min_chunk - 1) / min_chunk);
+        chunks          = std::max<std::size_t>(1, std::min(chunks, n));
+        auto chunk_size = (n + chunks - 1) / chunks;
+        std::vector<accumulator> partial(chunks * outputs, accumulator(self.init()));
+        par_for(chunks, 1, [&](auto c) {
+            auto r0 = c * chunk_size;
+            auto r1 = std::min(n, r0 + chunk_size);
+            for(std::size_t o = 0; o < outer and r0 < r1; o++)
+            {
+                auto* acc = partial.data() + c * outputs + o * inner;
+                this->reduce_rows(input + o * n * inner, r0, r1, inner, 0, inner, acc);
+            }
+        });
+        auto f = self.op();
+        for(std::size_t j = 0; j < outputs; j++)
+        {
+            accumulator val = self.init();
+            for(std::size_t c = 0; c < chunks; c++)
+                val = f(partial[c * outputs + j], val);
+            output[j] = out(val);
+        }
+    }
+
     argument compute(const shape& output_shape, std::vector<argument> args) const
     {
         argument result{output_shape};
@@ -135,6 +286,15 @@ struct reduce_op : op_name<Derived>
         std::vector<std::size_t> batch_lens(output_shape.lens().size(), 1);
         tune_dims(tuned_axes, arg_lens, batch_lens);
         shape batch_shape{output_shape.type(), batch_lens};
+        std::array<std::size_t, 3> dims{};
+        if(args[0].get_shape().standard() and output_shape.standard() and
+           output_shape.elements() > 0 and collapse_dims(arg_lens, tuned_axes, dims))
+        {
+            visit_all(result, args[0])([&](auto output, auto input) {
+                this->reduce_collapsed(input.data(), output.data(), dims, batch_shape);
+            });
+            return result;
+        }
         visit_all(result, args[0])([&](auto output, auto input) {
             par_for(output_shape.elements(), [&](auto i) {
                 auto out_idx = output_shape.multi(i);
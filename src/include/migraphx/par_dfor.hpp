@@ -3,6 +3,8 @@
 
 #include <migraphx/par_for.hpp>
 #include <migraphx/functional.hpp>
+#include <migraphx/dfor.hpp>
+#include <algorithm>
 #include <array>
 #include <numeric>
 
@@ -19,22 +21,30 @@ auto par_dfor(Ts... xs)
         const std::size_t min_grain = 8;
         if(n > 2 * min_grain)
         {
-            array_type strides;
-            strides.fill(1);
-            std::partial_sum(lens.rbegin(),
-                             lens.rend() - 1,
-                             strides.rbegin() + 1,
-                             std::multiplies<std::size_t>());
-            auto size =
-                std::accumulate(lens.begin(), lens.end(), 1, std::multiplies<std::size_t>());
-            par_for(size, min_grain, [&](std::size_t i) {
+            const std::size_t nchunks   = std::max<std::size_t>(
+                1, std::min<std::size_t>(std::thread::hardware_concurrency(), n / min_grain));
+            const std::size_t grainsize = (n + nchunks - 1) / nchunks;
+            par_for(nchunks, 1, [&](std::size_t chunk) {
+                const std::size_t start = chunk * grainsize;
+                const std::size_t last  = std::min<std::size_t>(n, start + grainsize);
+                // Only the first index of each chunk is divided out, the rest are carried over
                 array_type indices;
-                std::transform(strides.begin(),
-                               strides.end(),
-                               lens.begin(),
-                               indices.begin(),
-                               [&](size_t stride, size_t len) { return (i / stride) % len; });
-                migraphx::unpack(f, indices);
+                std::size_t j = start;
+                for(std::size_t k = lens.size(); k > 0; k--)
+                {
+                    indices[k - 1] = j % lens[k - 1];
+                    j /= lens[k - 1];
+                }
+                for(std::size_t i = start; i < last; i++)
+                {
+                    migraphx::unpack(f, indices);
+                    for(std::size_t k = lens.size(); k > 0; k--)
+                    {
+                        if(++indices[k - 1] < lens[k - 1])
+                            break;
+                        indices[k - 1] = 0;
+                    }
+                }
             });
         }
         else
@@ -9,6 +9,7 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_MEMORY_COLORING)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_REORDER_MEMORY)
 
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
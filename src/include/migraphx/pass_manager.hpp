@@ -21,8 +21,13 @@ struct module_pass_manager
     virtual ~module_pass_manager() {}
 };
 
+struct compile_profile;
+
 void run_passes(module& mod, const std::vector<pass>& passes, tracer trace = tracer{});
-void run_passes(program& prog, const std::vector<pass>& passes, tracer trace = tracer{});
+void run_passes(program& prog,
+                const std::vector<pass>& passes,
+                tracer trace             = tracer{},
+                compile_profile* profile = nullptr);
 
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -117,6 +117,9 @@ struct program
     std::unique_ptr<program_impl> impl;
 };
 
+// The name the operator is grouped under in performance reports
+std::string perf_group(const operation& op);
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
@@ -0,0 +1,64 @@
+#ifndef MIGRAPHX_GUARD_MIGRAPHLIB_PROGRAM_BUCKETS_HPP
+#define MIGRAPHX_GUARD_MIGRAPHLIB_PROGRAM_BUCKETS_HPP
+
+#include <migraphx/program.hpp>
+#include <migraphx/config.hpp>
+#include <map>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * @brief A family of programs for the same model, one per batch size
+ *
+ * Each bucket holds a program with a fixed batch size in the first dimension of its batched
+ * parameters. When evaluated, the smallest bucket that can hold the runtime batch is selected,
+ * the batched inputs are padded up to the batch size of that bucket, and the padding is removed
+ * from the batched outputs. A parameter or output is batched when its first dimension equals the
+ * batch size of its bucket in every bucket.
+ *
+ * Padding is done on the host, so programs compiled for a target with offloaded memory should be
+ * compiled with `offload_copy` enabled.
+ */
+struct program_buckets
+{
+    /// Add a program for a batch size, replacing any existing program for that batch size
+    void insert(std::size_t batch_size, program p);
+
+    bool empty() const;
+    std::size_t size() const;
+
+    /// The batch sizes of all buckets in increasing order
+    std::vector<std::size_t> get_batch_sizes() const;
+
+    /// Get the program for exactly this batch size
+    program& get(std::size_t batch_size);
+    const program& get(std::size_t batch_size) const;
+
+    /// Return the batch size of the smallest bucket that can hold `batch_size`
+    std::size_t select(std::size_t batch_size) const;
+
+    /// Names of the parameters that are padded along the batch dimension
+    std::vector<std::string> get_batched_parameter_names() const;
+
+    /// Whether the ith output is sliced along the batch dimension
+    bool is_batched_output(std::size_t i) const;
+
+    /// Make identical literals across all buckets share the same storage
+    void share_literals();
+
+    /// Compile all programs and share any literals that are identical after compiling
+    void compile(const target& t, compile_options options = compile_options{});
+
+    /// Evaluate the smallest bucket that fits the batch size of the parameters
+    std::vector<argument> eval(const parameter_map& params) const;
+
+    private:
+    std::map<std::size_t, program> programs;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
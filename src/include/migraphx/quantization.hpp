@@ -9,6 +9,7 @@
 #include <migraphx/target.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/env.hpp>
+#include <migraphx/value.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -17,11 +18,35 @@ struct program;
 
 void quantize_fp16(program& prog, const std::vector<std::string>& ins_names = {"all"});
 
+/**
+ * Searches for the largest set of instructions that can be converted to fp16 while the rms error
+ * of each output, relative to the fp32 program, stays within the error budget on the calibration
+ * data. The error of converting each instruction by itself is measured first to rank them, on its
+ * own output with a compile for each batch of 16 instructions of the main module, and on the
+ * outputs of the program with a compile for each instruction in a submodule. The instructions are
+ * then added from the least sensitive one with a binary search on the error of the outputs, so
+ * only that error is compared with the budget. The program is compiled on the target about log2
+ * of the number of instructions times for the search.
+ *
+ * The plan lists the instructions that are converted and the ones that are kept in fp32, by their
+ * module, position and operator. It is applied with `quantize_fp16_plan` to the same program
+ * before it is compiled, which throws when an instruction does not have the operator of the plan.
+ */
+value search_fp16_plan(const program& prog,
+                       const target& t,
+                       const std::vector<parameter_map>& calibration,
+                       double error_budget,
+                       const std::vector<std::string>& ins_names = {"all"});
+
+void quantize_fp16_plan(program& prog, const value& plan);
+
 void quantize_int8(program& prog,
                    const target& t,
                    const std::vector<parameter_map>& calibration,
                    const std::vector<std::string>& ins_names = {"dot", "convolution"});
 
+void quantize_weights(program& prog, std::size_t bits = 8, std::size_t group_size = 0);
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
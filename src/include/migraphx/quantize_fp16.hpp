@@ -2,6 +2,7 @@
 #define MIGRAPHX_GUARD_RTGLIB_QUANTIZE_FP16_HPP
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <migraphx/config.hpp>
 
@@ -17,6 +18,9 @@ struct module;
 struct quantize_fp16_pass
 {
     std::vector<std::string> ins_names = {"all"};
+    // When it is not empty, only the instructions at these positions of each module are
+    // converted, which is how a mixed precision plan is applied
+    std::unordered_map<std::string, std::vector<std::size_t>> ins_indices = {};
     std::string name() const { return "quantize_fp16"; }
     void apply(module& m) const;
 };
@@ -0,0 +1,28 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_QUANTIZE_WEIGHTS_HPP
+#define MIGRAPHX_GUARD_RTGLIB_QUANTIZE_WEIGHTS_HPP
+
+#include <string>
+#include <migraphx/config.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct module;
+
+/**
+ * Quantize the constant weights of dot instructions to 8 or 4 bits while the other input keeps
+ * its floating-point type. The dot is replaced by a dequant_dot with symmetric scales for each
+ * column, or for each group of `group_size` rows of a column when the group size is not 0.
+ */
+struct quantize_weights_pass
+{
+    std::size_t bits       = 8;
+    std::size_t group_size = 0;
+    std::string name() const { return "quantize_weights"; }
+    void apply(module& m) const;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
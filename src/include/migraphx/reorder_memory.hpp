@@ -0,0 +1,28 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_REORDER_MEMORY_HPP
+#define MIGRAPHX_GUARD_RTGLIB_REORDER_MEMORY_HPP
+
+#include <string>
+#include <migraphx/config.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+struct module;
+
+/**
+ * Reorders the instructions to reduce the scratch memory planned by `memory_coloring`. The
+ * instructions are scheduled greedily: among the instructions whose inputs are ready, the one that
+ * allocates the fewest bytes minus the bytes it frees goes first, and an allocation is moved right
+ * before its first use. The new order is only kept when it needs less scratch memory.
+ */
+struct reorder_memory
+{
+    std::string allocation_op{};
+    bool enable = true;
+    std::string name() const { return "reorder_memory"; }
+    void apply(module& m) const;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
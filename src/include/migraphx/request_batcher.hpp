@@ -0,0 +1,107 @@
+#ifndef MIGRAPHX_GUARD_MIGRAPHLIB_REQUEST_BATCHER_HPP
+#define MIGRAPHX_GUARD_MIGRAPHLIB_REQUEST_BATCHER_HPP
+
+#include <migraphx/program_buckets.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/config.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct request_batcher_options
+{
+    /// Largest number of samples evaluated together, 0 uses the largest bucket
+    std::size_t max_batch_size = 0;
+    /// How long the first request in the queue waits for more requests to arrive
+    std::chrono::microseconds max_delay{1000};
+};
+
+struct request_batcher_stats
+{
+    std::size_t requests = 0;
+    std::size_t batches  = 0;
+    /// Number of samples submitted by requests
+    std::size_t samples = 0;
+    /// Number of samples evaluated including the padding to the bucket size
+    std::size_t padded_samples = 0;
+    /// Sum of the time from submit to completion for all requests, in milliseconds
+    double total_latency = 0;
+    double max_latency   = 0;
+    /// Sum of the time requests spent waiting in the queue, in milliseconds
+    double total_queue_time = 0;
+    /// Time from the first submit to the last completion, in milliseconds
+    double elapsed = 0;
+
+    double average_latency() const;
+    double average_batch_size() const;
+    /// Samples completed per second
+    double throughput() const;
+};
+
+/**
+ * @brief Aggregates concurrent requests into batches evaluated by a program_buckets
+ *
+ * Each request holds the parameters for one or more samples along the batch dimension. A worker
+ * thread waits until either `max_batch_size` samples are queued or the oldest request has waited
+ * for `max_delay`, then concatenates the batched parameters of the queued requests, evaluates the
+ * smallest bucket that fits, and splits the batched outputs back to each request. Only
+ * consecutive requests with the same values for the parameters that are not batched are
+ * evaluated together, so a request with other values starts a new batch. Outputs that are not
+ * batched are returned to every request of the batch.
+ *
+ * The buckets should already be compiled and produce host memory.
+ */
+struct request_batcher
+{
+    request_batcher(program_buckets b, request_batcher_options options = {});
+    request_batcher(const request_batcher&) = delete;
+    request_batcher& operator=(const request_batcher&) = delete;
+    /// Evaluates any requests still queued before returning
+    ~request_batcher();
+
+    /// Queue a request, this can be called from any thread
+    std::future<std::vector<argument>> submit(parameter_map params);
+
+    request_batcher_stats get_stats() const;
+
+    private:
+    using clock = std::chrono::steady_clock;
+    struct request
+    {
+        parameter_map params;
+        std::size_t batch_size = 0;
+        clock::time_point submitted;
+        std::promise<std::vector<argument>> result;
+    };
+
+    bool same_unbatched(const request& x, const request& y) const;
+    /// The number of requests and of samples at the front of the queue to evaluate together
+    std::pair<std::size_t, std::size_t> next_batch() const;
+    void process();
+    void run_batch(std::vector<request> batch);
+
+    program_buckets buckets;
+    std::vector<std::string> batched_names;
+    std::vector<bool> batched_outputs;
+    std::size_t max_batch_size;
+    std::chrono::microseconds max_delay;
+
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<request> queue;
+    std::size_t queued_samples = 0;
+    bool stopped               = false;
+    request_batcher_stats stats;
+    clock::time_point first_submit;
+    joinable_thread worker;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -2,6 +2,7 @@
 #define MIGRAPHX_GUARD_RTGLIB_SCHEDULE_HPP
 
 #include <string>
+#include <migraphx/cost_model.hpp>
 #include <migraphx/instruction_ref.hpp>
 #include <migraphx/schedule_model.hpp>
 #include <migraphx/config.hpp>
@@ -12,12 +13,15 @@ inline namespace MIGRAPHX_INLINE_NS {
 struct module;
 
 /**
- * Schedule instructions for concurrent execution
+ * Schedule instructions for concurrent execution. The weights of the instructions are computed by
+ * the cost model, unless it is empty, while the schedule model still decides which instructions
+ * are free.
  */
 struct schedule
 {
     schedule_model model{};
-    bool enable = true;
+    bool enable     = true;
+    cost_model cost = {};
     std::string name() const { return "schedule"; }
     void apply(module& m) const;
 };
@@ -4,6 +4,7 @@
 #include <migraphx/shape.hpp>
 #include <migraphx/config.hpp>
 #include <algorithm>
+#include <cassert>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -14,18 +15,29 @@ void shape_for_each(const migraphx::shape& s, F f)
     // Ensure calls to f use const ref to vector
     auto call = [&f](const std::vector<std::size_t>& i) { f(i); };
     std::vector<std::size_t> indices(s.lens().size());
-    shape ss{s.type(), s.lens()};
-    for(std::size_t i = 0; i < ss.elements(); i++)
+    const auto& lens = s.lens();
+    auto elements    = s.elements();
+    if(elements == 0)
+        return;
+    if(lens.empty())
     {
-        std::transform(ss.strides().begin(),
-                       ss.strides().end(),
-                       ss.lens().begin(),
-                       indices.begin(),
-                       [&](std::size_t stride, std::size_t len) {
-                           assert(len > 0 and stride > 0);
-                           return (i / stride) % len;
-                       });
         call(indices);
+        return;
+    }
+    auto inner = lens.size() - 1;
+    for(std::size_t i = 0; i < elements; i += lens.back())
+    {
+        // Loop over the inner dimension directly and only carry into the outer dimensions after
+        for(indices[inner] = 0; indices[inner] < lens.back(); indices[inner]++)
+            call(indices);
+        indices[inner] = 0;
+        for(std::size_t k = inner; k > 0; k--)
+        {
+            assert(lens[k - 1] > 0);
+            if(++indices[k - 1] < lens[k - 1])
+                break;
+            indices[k - 1] = 0;
+        }
     }
 }
 
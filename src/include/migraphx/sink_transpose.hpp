@@ -0,0 +1,28 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_SINK_TRANSPOSE_HPP
+#define MIGRAPHX_GUARD_RTGLIB_SINK_TRANSPOSE_HPP
+
+#include <string>
+#include <migraphx/config.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct module;
+
+/**
+ * Moves transposes towards the outputs through pointwise, reduce, concat and slice operators, so
+ * that a transpose and its inverse meet and cancel, such as the transposes inserted around the
+ * operators of a model imported from NHWC. A transpose is only moved when the operator does not
+ * produce more elements than it reads, so a copy needed by a transpose that remains only gets
+ * cheaper.
+ */
+struct sink_transpose
+{
+    std::string name() const { return "sink_transpose"; }
+    void apply(module& m) const;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_SOFTMAX_HPP
+#define MIGRAPHX_GUARD_RTGLIB_SOFTMAX_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/shape.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * Computes the softmax, or the logsoftmax, of a standard tensor collapsed to `[outer, n, inner]`
+ * where `n` is the length of the axis. The maximum and the sum of the exponentials are computed
+ * together in one pass over the axis: the maximum of each block of the axis is found first, and
+ * the running sum is rescaled whenever the maximum grows. The output is written in a second pass.
+ *
+ * When the axis is not the innermost, a tile of the inner dimension is processed at a time, so
+ * each row of the axis is read as a contiguous block. The work is split into `tasks()`, which can
+ * be run in parallel, each for one outer index and one tile.
+ */
+template <class C>
+struct online_softmax
+{
+    std::size_t outer = 1;
+    std::size_t n     = 1;
+    std::size_t inner = 1;
+    bool log          = false;
+
+    // Number of columns of the inner dimension processed together
+    static constexpr std::size_t tile = 64;
+    // Number of elements of the axis whose maximum is found before they are summed
+    static constexpr std::size_t block = 16;
+    // The same for an innermost axis, where the elements of a block are contiguous
+    static constexpr std::size_t row_block = 256;
+
+    online_softmax(const shape& s, std::size_t axis, bool is_log)
+    {
+        const auto& lens = s.lens();
+        outer =
+            std::accumulate(lens.begin(), lens.begin() + axis, std::size_t{1}, std::multiplies<>{});
+        n     = lens[axis];
+        inner = std::accumulate(
+            lens.begin() + axis + 1, lens.end(), std::size_t{1}, std::multiplies<>{});
+        log = is_log;
+    }
+
+    std::size_t tiles() const { return (inner + tile - 1) / tile; }
+
+    std::size_t tasks() const { return outer * tiles(); }
+
+    template <class T, class U>
+    void contiguous(const T* x, U* y) const
+    {
+        C row_max = std::numeric_limits<C>::lowest();
+        C row_sum = 0;
+        for(std::size_t j0 = 0; j0 < n; j0 += row_block)
+        {
+            auto j1 = std::min(n, j0 + row_block);
+            C bmax  = std::numeric_limits<C>::lowest();
+            for(auto j = j0; j < j1; j++)
+                bmax = std::max<C>(bmax, x[j]);
+            if(bmax > row_max)
+            {
+                row_sum *= std::exp(row_max - bmax);
+                row_max = bmax;
+            }
+            // Sum the block first, so the rounding error does not grow with the length of the row
+            C bsum = 0;
+            for(auto j = j0; j < j1; j++)
+                bsum += std::exp(C(x[j]) - row_max);
+            row_sum += bsum;
+        }
+        for(std::size_t j = 0; j < n; j++)
+        {
+            C d  = C(x[j]) - row_max;
+            y[j] = log ? d - std::log(row_sum) : std::exp(d) / row_sum;
+        }
+    }
+
+    template <class T, class U>
+    void operator()(const T* input, U* output, std::size_t task) const
+    {
+        if(inner == 1)
+        {
+            this->contiguous(input + task * n, output + task * n);
+            return;
+        }
+        auto o      = task / tiles();
+        auto i0     = (task % tiles()) * tile;
+        auto cols   = std::min(tile, inner - i0);
+        auto offset = o * n * inner + i0;
+        input += offset;
+        output += offset;
+        std::array<C, tile> row_max;
+        std::array<C, tile> row_sum;
+        std::array<C, tile> bmax;
+        std::array<C, tile> bsum;
+        row_max.fill(std::numeric_limits<C>::lowest());
+        row_sum.fill(C{0});
+        for(std::size_t j0 = 0; j0 < n; j0 += block)
+        {
+            auto j1 = std::min(n, j0 + block);
+            bmax.fill(std::numeric_limits<C>::lowest());
+            for(auto j = j0; j < j1; j++)
+            {
+                const T* x = input + j * inner;
+                for(std::size_t i = 0; i < cols; i++)
+                    bmax[i] = std::max<C>(bmax[i], x[i]);
+            }
+            for(std::size_t i = 0; i < cols; i++)
+            {
+                if(bmax[i] <= row_max[i])
+                    continue;
+                row_sum[i] *= std::exp(row_max[i] - bmax[i]);
+                row_max[i] = bmax[i];
+            }
+            bsum.fill(C{0});
+            for(auto j = j0; j < j1; j++)
+            {
+                const T* x = input + j * inner;
+                for(std::size_t i = 0; i < cols; i++)
+                    bsum[i] += std::exp(C(x[i]) - row_max[i]);
+            }
+            for(std::size_t i = 0; i < cols; i++)
+                row_sum[i] += bsum[i];
+        }
+        for(std::size_t j = 0; j < n; j++)
+        {
+            const T* x = input + j * inner;
+            U* y       = output + j * inner;
+            for(std::size_t i = 0; i < cols; i++)
+            {
+                C d  = C(x[i]) - row_max[i];
+                y[i] = log ? d - std::log(row_sum[i]) : std::exp(d) / row_sum[i];
+            }
+        }
+    }
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef MIGRAPHX_GUARD_MIGRAPHLIB_STRIDED_INDEX_HPP
+#define MIGRAPHX_GUARD_MIGRAPHLIB_STRIDED_INDEX_HPP
+
+#include <migraphx/shape.hpp>
+#include <migraphx/config.hpp>
+#include <array>
+#include <cassert>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * @brief Maps consecutive element indices of a shape to offsets into its data
+ *
+ * Instead of dividing the element index by every stride, the N-d index is carried over from the
+ * previous element, so stepping to the next element is an add and a compare in the common case.
+ * Dimensions of size one are dropped and each dimension that is contiguous with the next inner
+ * dimension is merged into it, so a standard shape is iterated as a single dimension.
+ */
+struct strided_index
+{
+    strided_index() = default;
+
+    strided_index(const shape& s, std::size_t i = 0)
+    {
+        if(s.elements() > 0)
+        {
+            merge_dims(s, [&](std::size_t, std::size_t) { n++; });
+            if(n > max_size)
+                large.resize(n);
+            auto* d       = dims();
+            std::size_t k = n;
+            merge_dims(s, [&](std::size_t len, std::size_t stride) {
+                k--;
+                d[k].len    = len;
+                d[k].stride = stride;
+            });
+        }
+        this->reset(i);
+    }
+
+    /// The element index
+    std::size_t element() const { return m_element; }
+
+    /// The offset of the element into the data
+    std::size_t offset() const { return m_offset; }
+
+    void reset(std::size_t i)
+    {
+        m_element = i;
+        m_offset  = 0;
+        auto* d   = dims();
+        for(std::size_t k = n; k > 0; k--)
+        {
+            auto& x = d[k - 1];
+            // The outer dimension is not wrapped so the end of the shape can be represented
+            if(k == 1)
+            {
+                x.index = i;
+            }
+            else
+            {
+                x.index = i % x.len;
+                i /= x.len;
+            }
+            m_offset += x.index * x.stride;
+        }
+    }
+
+    void increment()
+    {
+        m_element++;
+        if(n == 0)
+            return;
+        auto* d = dims();
+        auto k  = n - 1;
+        d[k].index++;
+        m_offset += d[k].stride;
+        while(k > 0 and d[k].index == d[k].len)
+        {
+            d[k].index = 0;
+            m_offset -= d[k].len * d[k].stride;
+            k--;
+            d[k].index++;
+            m_offset += d[k].stride;
+        }
+    }
+
+    void decrement()
+    {
+        assert(m_element > 0);
+        m_element--;
+        if(n == 0)
+            return;
+        auto* d = dims();
+        auto k  = n - 1;
+        while(k > 0 and d[k].index == 0)
+        {
+            d[k].index = d[k].len - 1;
+            m_offset += d[k].index * d[k].stride;
+            k--;
+        }
+        d[k].index--;
+        m_offset -= d[k].stride;
+    }
+
+    strided_index& operator+=(std::ptrdiff_t x)
+    {
+        if(x == 1)
+            this->increment();
+        else if(x == -1)
+            this->decrement();
+        else if(x != 0)
+            this->reset(m_element + x);
+        return *this;
+    }
+
+    strided_index& operator-=(std::ptrdiff_t x) { return *this += -x; }
+
+    strided_index& operator++()
+    {
+        this->increment();
+        return *this;
+    }
+
+    strided_index& operator--()
+    {
+        this->decrement();
+        return *this;
+    }
+
+    private:
+    struct dim
+    {
+        std::size_t len    = 0;
+        std::size_t stride = 0;
+        std::size_t index  = 0;
+    };
+
+    dim* dims() { return n > max_size ? large.data() : small.data(); }
+
+    // Calls f with the length and stride of each merged dimension, starting from the innermost
+    template <class F>
+    static void merge_dims(const shape& s, F f)
+    {
+        const auto& lens    = s.lens();
+        const auto& strides = s.strides();
+        std::size_t len     = 1;
+        std::size_t stride  = 0;
+        for(std::size_t k = lens.size(); k > 0; k--)
+        {
+            if(lens[k - 1] == 1)
+                continue;
+            if(len != 1 and stride * len == strides[k - 1])
+            {
+                len *= lens[k - 1];
+            }
+            else
+            {
+                if(len != 1)
+                    f(len, stride);
+                len    = lens[k - 1];
+                stride = strides[k - 1];
+            }
+        }
+        if(len != 1)
+            f(len, stride);
+    }
+
+    static const std::size_t max_size = 6;
+    std::array<dim, max_size> small   = {};
+    // Only used when there are more dimensions than fit in small
+    std::vector<dim> large = {};
+    std::size_t n          = 0;
+    std::size_t m_element  = 0;
+    std::size_t m_offset   = 0;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
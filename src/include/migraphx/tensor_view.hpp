@@ -4,10 +4,11 @@
 #include <migraphx/shape.hpp>
 #include <migraphx/float_equal.hpp>
 #include <migraphx/requires.hpp>
-#include <migraphx/iota_iterator.hpp>
+#include <migraphx/strided_index.hpp>
 #include <migraphx/config.hpp>
 
 #include <iostream>
+#include <iterator>
 #include <utility>
 
 namespace migraphx {
@@ -22,13 +23,111 @@ inline int32_t as_number(int8_t x) { return static_cast<int32_t>(x); }
 inline uint32_t as_number(uint8_t x) { return static_cast<uint32_t>(x); }
 
 template <class T>
-struct tensor_view_iterator_read
+struct tensor_view_iterator
 {
-    T* view;
-    auto& operator()(std::size_t n) const
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = typename std::remove_cv<T>::type;
+    using reference         = T&;
+    using pointer           = T*;
+    using iterator_category = std::random_access_iterator_tag;
+
+    T* data = nullptr;
+    strided_index index{};
+
+    reference operator*() const
+    {
+        assert(data != nullptr);
+        return data[index.offset()];
+    }
+
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    tensor_view_iterator& operator+=(difference_type n)
+    {
+        index += n;
+        return *this;
+    }
+
+    tensor_view_iterator& operator-=(difference_type n)
+    {
+        index -= n;
+        return *this;
+    }
+
+    tensor_view_iterator& operator++()
+    {
+        ++index;
+        return *this;
+    }
+
+    tensor_view_iterator& operator--()
+    {
+        --index;
+        return *this;
+    }
+
+    tensor_view_iterator operator++(int) // NOLINT
+    {
+        tensor_view_iterator it = *this;
+        ++index;
+        return it;
+    }
+
+    tensor_view_iterator operator--(int) // NOLINT
+    {
+        tensor_view_iterator it = *this;
+        --index;
+        return it;
+    }
+
+    friend tensor_view_iterator operator+(tensor_view_iterator x, difference_type y)
+    {
+        return x += y;
+    }
+
+    friend tensor_view_iterator operator+(difference_type x, tensor_view_iterator y)
+    {
+        return y += x;
+    }
+
+    friend tensor_view_iterator operator-(tensor_view_iterator x, difference_type y)
+    {
+        return x -= y;
+    }
+
+    friend difference_type operator-(const tensor_view_iterator& x, const tensor_view_iterator& y)
+    {
+        return x.index.element() - y.index.element();
+    }
+
+    friend bool operator==(const tensor_view_iterator& x, const tensor_view_iterator& y)
+    {
+        return x.index.element() == y.index.element();
+    }
+
+    friend bool operator!=(const tensor_view_iterator& x, const tensor_view_iterator& y)
+    {
+        return x.index.element() != y.index.element();
+    }
+
+    friend bool operator<(const tensor_view_iterator& x, const tensor_view_iterator& y)
+    {
+        return x.index.element() < y.index.element();
+    }
+
+    friend bool operator>(const tensor_view_iterator& x, const tensor_view_iterator& y)
+    {
+        return x.index.element() > y.index.element();
+    }
+
+    friend bool operator<=(const tensor_view_iterator& x, const tensor_view_iterator& y)
+    {
+        return x.index.element() <= y.index.element();
+    }
+
+    friend bool operator>=(const tensor_view_iterator& x, const tensor_view_iterator& y)
     {
-        assert(view != nullptr);
-        return (*view)[n];
+        return x.index.element() >= y.index.element();
     }
 };
 
@@ -36,9 +135,8 @@ template <class T>
 struct tensor_view
 {
     using value_type = T;
-    using iterator   = basic_iota_iterator<tensor_view_iterator_read<tensor_view<T>>, std::size_t>;
-    using const_iterator =
-        basic_iota_iterator<tensor_view_iterator_read<const tensor_view<T>>, std::size_t>;
+    using iterator       = tensor_view_iterator<T>;
+    using const_iterator = tensor_view_iterator<const T>;
     tensor_view() : m_data(nullptr) {}
     tensor_view(shape s, T* d) : m_data(d), m_shape(std::move(s)) {}
 
@@ -120,13 +218,13 @@ struct tensor_view
         return m_data[m_shape.index(this->size() - 1)];
     }
 
-    iterator begin() { return {0, {this}}; }
+    iterator begin() { return {m_data, strided_index{m_shape}}; }
 
-    iterator end() { return {this->size(), {this}}; }
+    iterator end() { return {m_data, strided_index{m_shape, this->size()}}; }
 
-    const_iterator begin() const { return {0, {this}}; }
+    const_iterator begin() const { return {m_data, strided_index{m_shape}}; }
 
-    const_iterator end() const { return {this->size(), {this}}; }
+    const_iterator end() const { return {m_data, strided_index{m_shape, this->size()}}; }
 
     template <class U = T>
     std::vector<U> to_vector() const
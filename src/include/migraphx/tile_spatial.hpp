@@ -0,0 +1,31 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_TILE_SPATIAL_HPP
+#define MIGRAPHX_GUARD_RTGLIB_TILE_SPATIAL_HPP
+
+#include <string>
+#include <migraphx/config.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct module;
+
+/**
+ * Splits a chain of convolution, pooling and pointwise operators into tiles along the height, so
+ * that the intermediate feature maps of a tile fit in cache instead of being written to memory
+ * for the whole image. Each tile reads the rows of the input it needs, including the halo rows
+ * of the windows, and computes the chain up to its rows of the output, which are concatenated. A
+ * chain is only tiled when an intermediate is larger than `tile_bytes`.
+ */
+struct tile_spatial
+{
+    std::size_t tile_bytes = 1024 * 1024;
+    // Tiles with fewer rows of output would recompute too many halo rows
+    std::size_t min_rows = 8;
+    std::string name() const { return "tile_spatial"; }
+    void apply(module& m) const;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,51 @@
+#include <migraphx/literal_pool.hpp>
+#include <cstring>
+#include <ostream>
+#include <string_view>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static std::size_t hash_literal(const literal& l)
+{
+    return std::hash<std::string_view>{}(std::string_view{l.data(), l.get_shape().bytes()});
+}
+
+literal literal_pool::add(const literal& l)
+{
+    if(l.empty())
+        return l;
+    stats.lookups++;
+    auto bytes = l.get_shape().bytes();
+    auto h     = hash_literal(l);
+    auto range = entries.equal_range(h);
+    for(auto it = range.first; it != range.second; ++it)
+    {
+        const auto& x = it->second;
+        if(x.get_shape().bytes() != bytes)
+            continue;
+        if(x.data() == l.data())
+            return l;
+        if(std::memcmp(x.data(), l.data(), bytes) != 0)
+            continue;
+        stats.hits++;
+        stats.bytes_saved += bytes;
+        return {l.get_shape(), x.get_buffer()};
+    }
+    entries.emplace(h, l);
+    stats.buffers++;
+    stats.bytes += bytes;
+    return l;
+}
+
+literal_pool_stats literal_pool::get_stats() const { return stats; }
+
+std::ostream& operator<<(std::ostream& os, const literal_pool_stats& x)
+{
+    os << "lookups: " << x.lookups << ", hits: " << x.hits << ", bytes saved: " << x.bytes_saved
+       << ", buffers: " << x.buffers << ", bytes: " << x.bytes;
+    return os;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
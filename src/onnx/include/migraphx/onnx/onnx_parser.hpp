@@ -88,9 +88,16 @@ struct onnx_parser
 
     void parse_from(std::istream& is, std::string name = "");
     void parse_from(const void* data, std::size_t size);
+    void parse_main_graph(module* mod, onnx::GraphProto& graph);
     void parse_graph(module* mod, const onnx::GraphProto& graph);
+    void parse_graph(module* mod,
+                     const onnx::GraphProto& graph,
+                     std::unordered_map<std::string, instruction_ref> mod_insts);
     literal parse_value(const onnx::AttributeProto& attr) const;
     literal parse_tensor(const onnx::TensorProto& t) const;
+    /// Parse the tensor and move its data out of it
+    literal release_tensor(onnx::TensorProto& t) const;
+    std::vector<char> read_external_data(const onnx::TensorProto& t) const;
     shape parse_type(const onnx::TypeProto& t, const std::vector<std::size_t>& input_dims) const;
 };
 
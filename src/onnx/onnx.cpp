@@ -59,6 +59,27 @@ program parse_onnx_buffer(const void* data, std::size_t size, const onnx_options
     return parse_onnx_from(options, data, size);
 }
 
+program_buckets parse_onnx_buckets(const std::string& name,
+                                   const std::vector<std::size_t>& batch_sizes,
+                                   const onnx_options& options)
+{
+    program_buckets result;
+    for(auto batch_size : batch_sizes)
+    {
+        onnx_options batch_options      = options;
+        batch_options.default_dim_value = batch_size;
+        // Explicitly specified dims are batched in their first dimension
+        for(auto&& p : batch_options.map_input_dims)
+        {
+            if(not p.second.empty())
+                p.second.front() = batch_size;
+        }
+        result.insert(batch_size, parse_onnx(name, batch_options));
+    }
+    result.share_literals();
+    return result;
+}
+
 std::vector<std::string> get_onnx_operators() { return onnx::get_op_parsers(); }
 
 } // namespace MIGRAPHX_INLINE_NS
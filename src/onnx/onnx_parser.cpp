@@ -44,6 +44,26 @@ create_literal(shape::type_t shape_type, const std::vector<size_t>& dims, const
     return literal{{shape_type, dims}, data};
 }
 
+// Create a literal that keeps the container alive and uses its bytes without copying them
+template <class Container>
+static literal alias_literal(shape::type_t shape_type,
+                             const std::vector<size_t>& dims,
+                             std::shared_ptr<Container> data)
+{
+    // empty input
+    auto elem_num =
+        std::accumulate(dims.begin(), dims.end(), std::size_t(1), std::multiplies<std::size_t>());
+    if(elem_num == 0)
+    {
+        return {};
+    }
+
+    shape s = dims.empty() ? shape{shape_type} : shape{shape_type, dims};
+    if(data->size() < s.bytes())
+        MIGRAPHX_THROW("PARSE_TENSOR: Not enough data for tensor of shape " + to_string(s));
+    return literal{s, std::shared_ptr<char>(data, data->data())};
+}
+
 template <class T, MIGRAPHX_REQUIRES(not std::is_pointer<T>{})>
 static literal create_literal(shape::type_t shape_type, const std::vector<size_t>& dims, T data)
 {
@@ -186,7 +206,7 @@ void onnx_parser::parse_from(std::istream& is, std::string name)
 
         if(model.has_graph())
         {
-            this->parse_graph(mm, model.graph());
+            this->parse_main_graph(mm, *model.mutable_graph());
         }
     }
     else
@@ -206,7 +226,7 @@ void onnx_parser::parse_from(const void* data, std::size_t size)
 
         if(model.has_graph())
         {
-            this->parse_graph(mm, model.graph());
+            this->parse_main_graph(mm, *model.mutable_graph());
         }
     }
     else
@@ -230,6 +250,17 @@ int64_t onnx_parser::get_opset_version(const onnx::ModelProto& model)
     return version;
 }
 
+void onnx_parser::parse_main_graph(module* mod, onnx::GraphProto& graph)
+{
+    std::unordered_map<std::string, instruction_ref> mod_insts;
+    for(auto&& f : *graph.mutable_initializer())
+    {
+        // The data is moved out of the tensor, so the weights are not held twice while parsing
+        mod_insts[f.name()] = mod->add_literal(release_tensor(f));
+    }
+    this->parse_graph(mod, graph, std::move(mod_insts));
+}
+
 void onnx_parser::parse_graph(module* mod, const onnx::GraphProto& graph)
 {
     std::unordered_map<std::string, instruction_ref> mod_insts;
@@ -238,7 +269,13 @@ void onnx_parser::parse_graph(module* mod, const onnx::GraphProto& graph)
         // backup instructions in parent mod
         mod_insts[f.name()] = mod->add_literal(parse_tensor(f));
     }
+    this->parse_graph(mod, graph, std::move(mod_insts));
+}
 
+void onnx_parser::parse_graph(module* mod,
+                              const onnx::GraphProto& graph,
+                              std::unordered_map<std::string, instruction_ref> mod_insts)
+{
     for(auto&& input : graph.input())
     {
         const std::string& name = input.name();
@@ -357,16 +394,50 @@ literal onnx_parser::parse_value(const onnx::AttributeProto& attr) const
     MIGRAPHX_THROW("PARSE_VALUE: Invalid attribute type " + std::to_string(attr.type()));
 }
 
+std::vector<char> onnx_parser::read_external_data(const onnx::TensorProto& t) const
+{
+    std::string location = t.external_data().at(0).value();
+    std::size_t offset   = 0;
+    std::size_t length   = 0;
+    for(auto&& entry : t.external_data())
+    {
+        if(entry.key() == "location")
+            location = entry.value();
+        else if(entry.key() == "offset")
+            offset = std::stoull(entry.value());
+        else if(entry.key() == "length")
+            length = std::stoull(entry.value());
+    }
+    return read_buffer(path + "/" + location, offset, length);
+}
+
+literal onnx_parser::release_tensor(onnx::TensorProto& t) const
+{
+    if(not t.has_raw_data() or not t.external_data().empty())
+    {
+        auto result = parse_tensor(t);
+        t.clear_int32_data();
+        t.clear_int64_data();
+        t.clear_uint64_data();
+        t.clear_float_data();
+        t.clear_double_data();
+        return result;
+    }
+    std::vector<std::size_t> dims(t.dims().begin(), t.dims().end());
+    auto type = get_type(t.data_type());
+    auto data = std::make_shared<std::string>(std::move(*t.mutable_raw_data()));
+    t.clear_raw_data();
+    return alias_literal(type, dims, data);
+}
+
 literal onnx_parser::parse_tensor(const onnx::TensorProto& t) const
 {
     std::vector<std::size_t> dims(t.dims().begin(), t.dims().end());
     if(not t.external_data().empty())
     {
-        const std::string& data_file = t.external_data().at(0).value();
-        auto raw_buffer              = read_buffer(path + "/" + data_file);
-        std::string s(raw_buffer.begin(), raw_buffer.end());
         auto type = get_type(t.data_type());
-        return create_literal(type, dims, s.data());
+        auto data = std::make_shared<std::vector<char>>(read_external_data(t));
+        return alias_literal(type, dims, data);
     }
     if(t.has_raw_data())
     {
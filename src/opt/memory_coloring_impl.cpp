@@ -18,13 +18,7 @@ void memory_coloring_impl::run()
     if(num_of_lives != 0)
     {
         MIGRAPHX_DEBUG(dump_intervals());
-        // Coloring
-        while(!alloc_queue.empty())
-        {
-            interval_ptr interval = alloc_queue.top();
-            allocate(interval);
-            alloc_queue.pop();
-        }
+        color();
 
         // rewrite happens after all modules are processed
         rewrite();
@@ -34,6 +28,24 @@ void memory_coloring_impl::run()
     }
 }
 
+std::size_t memory_coloring_impl::compute_required_bytes()
+{
+    mod_implicit_deps = p_mod->calc_implicit_deps();
+    build();
+    color();
+    return required_bytes;
+}
+
+void memory_coloring_impl::color()
+{
+    while(!alloc_queue.empty())
+    {
+        interval_ptr interval = alloc_queue.top();
+        allocate(interval);
+        alloc_queue.pop();
+    }
+}
+
 bool memory_coloring_impl::allocate(interval_ptr interval)
 {
     shape s          = interval->result;
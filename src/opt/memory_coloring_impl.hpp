@@ -79,8 +79,11 @@ struct memory_coloring_impl
         }
     }
     void build();
+    void color();
     void run();
     void rewrite();
+    // Computes the size of the scratch memory without rewriting the module
+    std::size_t compute_required_bytes();
 
     private:
     static bool is_param(const instruction_ref ins) { return ins->name() == "@param"; }
@@ -0,0 +1,191 @@
+#include <migraphx/reorder_memory.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/ranges.hpp>
+#include "memory_coloring_impl.hpp"
+#include <iostream>
+#include <unordered_set>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_REORDER_MEMORY)
+
+static std::size_t scratch_bytes(module& m, const std::string& allocation_op)
+{
+    memory_coloring_impl opt(&m, allocation_op, false);
+    return opt.compute_required_bytes();
+}
+
+struct memory_scheduler
+{
+    module* m;
+    std::string allocation_op;
+    ins_dep_map implicit_deps{};
+    std::unordered_map<instruction_ref, std::size_t> position{};
+    // Number of inputs not scheduled yet, other than allocations which are scheduled with the user
+    std::unordered_map<instruction_ref, std::size_t> pending{};
+    std::unordered_map<instruction_ref, std::vector<instruction_ref>> users{};
+    // The allocations that an instruction reads or writes through its inputs
+    std::unordered_map<instruction_ref, std::vector<instruction_ref>> buffers{};
+    // Number of instructions not scheduled yet that use an allocation
+    std::unordered_map<instruction_ref, std::size_t> uses{};
+    std::unordered_set<instruction_ref> scheduled{};
+    std::vector<instruction_ref> order{};
+
+    bool is_allocation(instruction_ref ins) const { return ins->name() == allocation_op; }
+
+    std::vector<instruction_ref> get_inputs(instruction_ref ins) const
+    {
+        auto inputs = ins->inputs();
+        if(contains(implicit_deps, ins))
+        {
+            const auto& deps = implicit_deps.at(ins);
+            inputs.insert(inputs.end(), deps.begin(), deps.end());
+        }
+        inputs.erase(std::remove_if(inputs.begin(),
+                                    inputs.end(),
+                                    [&](auto input) { return not m->has_instruction(input); }),
+                     inputs.end());
+        return inputs;
+    }
+
+    void build()
+    {
+        implicit_deps = m->calc_implicit_deps();
+        std::size_t n = 0;
+        for(auto ins : iterator_for(*m))
+        {
+            position[ins] = n++;
+            pending[ins]  = 0;
+            std::unordered_set<instruction_ref> ins_buffers;
+            for(auto input : get_inputs(ins))
+            {
+                if(not is_allocation(input))
+                {
+                    pending[ins]++;
+                    users[input].push_back(ins);
+                }
+                auto alias = instruction::get_output_alias(input);
+                if(is_allocation(alias))
+                    ins_buffers.insert(alias);
+            }
+            buffers[ins].assign(ins_buffers.begin(), ins_buffers.end());
+            for(auto buffer : buffers[ins])
+                uses[buffer]++;
+        }
+    }
+
+    // The bytes allocated minus the bytes freed when the instruction is scheduled next
+    std::ptrdiff_t cost(instruction_ref ins) const
+    {
+        std::ptrdiff_t result = 0;
+        for(auto buffer : buffers.at(ins))
+        {
+            auto bytes = static_cast<std::ptrdiff_t>(buffer->get_shape().bytes());
+            if(not contains(scheduled, buffer))
+                result += bytes;
+            if(uses.at(buffer) == 1)
+                result -= bytes;
+        }
+        return result;
+    }
+
+    void schedule(instruction_ref ins, std::vector<instruction_ref>& ready)
+    {
+        for(auto input : get_inputs(ins))
+        {
+            if(is_allocation(input) and not contains(scheduled, input))
+            {
+                scheduled.insert(input);
+                order.push_back(input);
+            }
+        }
+        scheduled.insert(ins);
+        order.push_back(ins);
+        for(auto buffer : buffers[ins])
+            uses[buffer]--;
+        for(auto user : users[ins])
+        {
+            if(--pending[user] == 0)
+                ready.push_back(user);
+        }
+    }
+
+    // Returns an empty order when some instructions could not be scheduled
+    std::vector<instruction_ref> run()
+    {
+        build();
+        std::vector<instruction_ref> start;
+        for(auto ins : iterator_for(*m))
+        {
+            if(not is_allocation(ins) and pending[ins] == 0)
+                start.push_back(ins);
+        }
+        std::vector<instruction_ref> ready;
+        // Parameters and literals stay first
+        for(auto ins : start)
+        {
+            if(get_inputs(ins).empty())
+                schedule(ins, ready);
+            else
+                ready.push_back(ins);
+        }
+        while(not ready.empty())
+        {
+            // The return is only scheduled last, and ties are broken by the original order
+            auto it = std::min_element(ready.begin(), ready.end(), [&](auto x, auto y) {
+                return std::make_tuple(x->name() == "@return", cost(x), position[x]) <
+                       std::make_tuple(y->name() == "@return", cost(y), position[y]);
+            });
+            auto ins = *it;
+            ready.erase(it);
+            schedule(ins, ready);
+        }
+        // Allocations that are not used go before the return
+        auto last = order.empty() or order.back()->name() != "@return" ? order.end()
+                                                                         : std::prev(order.end());
+        std::vector<instruction_ref> unused;
+        for(auto ins : iterator_for(*m))
+        {
+            if(contains(scheduled, ins))
+                continue;
+            if(not is_allocation(ins))
+                return {};
+            unused.push_back(ins);
+        }
+        order.insert(last, unused.begin(), unused.end());
+        return order;
+    }
+};
+
+void reorder_memory::apply(module& m) const
+{
+    if(not enable or m.size() < 2)
+        return;
+    std::vector<instruction_ref> original;
+    for(auto ins : iterator_for(m))
+        original.push_back(ins);
+    auto order = memory_scheduler{&m, allocation_op}.run();
+    if(order.size() != original.size())
+        return;
+
+    auto before = scratch_bytes(m, allocation_op);
+    for(auto ins : order)
+        m.move_instruction(ins, m.end());
+    auto after = scratch_bytes(m, allocation_op);
+    bool keep  = after < before;
+    if(not keep)
+    {
+        for(auto ins : original)
+            m.move_instruction(ins, m.end());
+    }
+    if(enabled(MIGRAPHX_TRACE_REORDER_MEMORY{}))
+    {
+        std::cout << "Scratch memory of " << m.name() << ": " << before << " bytes, reordered "
+                  << after << " bytes" << (keep ? "" : ", keeping the original order")
+                  << std::endl;
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -1,4 +1,5 @@
 #include <migraphx/program.hpp>
+#include <migraphx/compile_profile.hpp>
 #include <migraphx/pass_manager.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/instruction.hpp>
@@ -34,10 +35,33 @@ void validate_pass(module& mod, const pass& p, tracer trace)
     trace();
 #endif
 }
-void run_pass(program& prog, const pass& p, tracer trace)
+void run_pass(program& prog, const pass& p, tracer trace, compile_profile* profile)
 {
     trace("Pass: ", p.name());
-    p.apply(prog);
+    if(profile == nullptr)
+    {
+        p.apply(prog);
+    }
+    else
+    {
+        // Most passes only apply to the modules, so the program is only recorded when the pass
+        // changes it, rather than adding an empty record for every pass
+        using milliseconds = std::chrono::duration<double, std::milli>;
+        auto before        = compile_profile::get_totals(prog);
+        auto begin         = std::chrono::steady_clock::now();
+        p.apply(prog);
+        auto end   = std::chrono::steady_clock::now();
+        auto after = compile_profile::get_totals(prog);
+        if(before.instructions != after.instructions or
+           before.literal_bytes != after.literal_bytes or
+           before.scratch_bytes != after.scratch_bytes)
+            profile->add(p.name(),
+                         "",
+                         before,
+                         after,
+                         milliseconds(begin - profile->start).count(),
+                         milliseconds(end - begin).count());
+    }
     trace(prog);
 }
 
@@ -46,9 +70,13 @@ struct module_pm : module_pass_manager
     module* mod;
     program* prog;
     tracer* t;
+    compile_profile* profile;
 
-    module_pm(module* pmod = nullptr, program* pprog = nullptr, tracer* pt = nullptr)
-        : mod(pmod), prog(pprog), t(pt)
+    module_pm(module* pmod              = nullptr,
+              program* pprog            = nullptr,
+              tracer* pt                = nullptr,
+              compile_profile* pprofile = nullptr)
+        : mod(pmod), prog(pprog), t(pt), profile(pprofile)
     {
     }
 
@@ -74,7 +102,10 @@ struct module_pm : module_pass_manager
         assert(mod);
         trace("Module: ", mod->name(), ", Pass: ", p.name());
         assert(mod->validate() == mod->end());
-        p.apply(*this);
+        if(profile == nullptr)
+            p.apply(*this);
+        else
+            profile->run(p.name(), mod->name(), *mod, [&] { p.apply(*this); });
         trace(*mod);
         validate_pass(*mod, p, *t);
     }
@@ -92,7 +123,10 @@ void run_passes(module& mod, const std::vector<pass>& passes, tracer trace)
     }
 }
 
-void run_passes(program& prog, const std::vector<pass>& passes, tracer trace)
+void run_passes(program& prog,
+                const std::vector<pass>& passes,
+                tracer trace,
+                compile_profile* profile)
 {
     if(enabled(MIGRAPHX_TRACE_PASSES{}))
         trace = tracer{std::cout};
@@ -103,9 +137,9 @@ void run_passes(program& prog, const std::vector<pass>& passes, tracer trace)
         {
             if(mod->bypass())
                 continue;
-            module_pm{mod, &prog, &trace}.run_pass(p);
+            module_pm{mod, &prog, &trace, profile}.run_pass(p);
         }
-        run_pass(prog, p, trace);
+        run_pass(prog, p, trace, profile);
     }
 }
 
@@ -1,4 +1,5 @@
 #include <migraphx/program.hpp>
+#include <migraphx/compile_profile.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/op/identity.hpp>
@@ -27,6 +28,9 @@
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_COMPILE_PROFILE)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_COMPILE_TRACE)
+
 using milliseconds = std::chrono::duration<double, std::milli>;
 
 struct program_impl
@@ -143,14 +147,28 @@ void program::compile(const target& t, compile_options options)
     assert(not this->is_compiled());
     this->impl->target_name = t.name();
     this->impl->ctx         = t.get_context();
+    if(not options.context.is_null())
+        this->impl->ctx.from_value(options.context);
     if(enabled(MIGRAPHX_TRACE_COMPILE{}))
         options.trace = tracer{std::cout};
 
     options.trace(*this);
     options.trace();
 
+    // The environment variables name the files the profile is written to
+    auto profile_file = string_value_of(MIGRAPHX_COMPILE_PROFILE{});
+    auto trace_file   = string_value_of(MIGRAPHX_COMPILE_TRACE{});
+    compile_profile env_profile;
+    if(options.profile == nullptr and not(profile_file.empty() and trace_file.empty()))
+        options.profile = &env_profile;
+    if(options.profile != nullptr)
+    {
+        options.profile->target = t.name();
+        options.profile->start  = std::chrono::steady_clock::now();
+    }
+
     auto&& passes = t.get_passes(this->impl->ctx, options);
-    run_passes(*this, passes, options.trace);
+    run_passes(*this, passes, options.trace, options.profile);
 
     auto mods = this->get_modules();
 
@@ -170,7 +188,19 @@ void program::compile(const target& t, compile_options options)
             MIGRAPHX_THROW("Dangling reference in module " + mod->name() + " from instruction " +
                            std::to_string(index));
         }
-        mod->finalize(this->impl->ctx);
+        if(options.profile == nullptr)
+            mod->finalize(this->impl->ctx);
+        else
+            options.profile->run(
+                "finalize", mod->name(), *mod, [&] { mod->finalize(this->impl->ctx); });
+    }
+
+    if(options.profile != nullptr)
+    {
+        if(not profile_file.empty())
+            options.profile->write(profile_file);
+        if(not trace_file.empty())
+            options.profile->write(trace_file, true);
     }
 }
 
@@ -669,7 +699,7 @@ void program::perf_report(std::ostream& os,
 
     std::unordered_map<instruction_ref, std::string> names;
     this->print(names, [&](auto ins, auto ins_names) {
-        instruction::print(std::cout, ins, ins_names);
+        instruction::print(os, ins, ins_names);
 
         // skip return instruction
         if(ins->name() == "@return")
@@ -0,0 +1,185 @@
+#include <migraphx/program_buckets.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/literal_pool.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/errors.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static bool is_batched(const shape& s, std::size_t batch_size)
+{
+    return s.type() != shape::tuple_type and not s.lens().empty() and
+           s.lens().front() == batch_size;
+}
+
+static argument pad_batch(const argument& arg, const shape& s)
+{
+    auto lens    = arg.get_shape().lens();
+    auto to_lens = s.lens();
+    if(arg.get_shape().type() != s.type() or lens.size() != to_lens.size() or
+       not std::equal(lens.begin() + 1, lens.end(), to_lens.begin() + 1))
+        MIGRAPHX_THROW("PROGRAM_BUCKETS: Cannot pad argument " + to_string(arg.get_shape()) +
+                       " to " + to_string(s));
+    argument result{s};
+    std::fill(result.data(), result.data() + s.bytes(), 0);
+    visit_all(result, arg)(
+        [&](auto output, auto input) { std::copy(input.begin(), input.end(), output.begin()); });
+    return result;
+}
+
+static argument unpad_batch(const argument& arg, std::size_t batch_size)
+{
+    const auto& s = arg.get_shape();
+    auto lens     = s.lens();
+    lens.front()  = batch_size;
+    return arg.reshape(shape{s.type(), lens, s.strides()});
+}
+
+void program_buckets::insert(std::size_t batch_size, program p)
+{
+    if(batch_size == 0)
+        MIGRAPHX_THROW("PROGRAM_BUCKETS: Batch size must be greater than zero");
+    programs[batch_size] = std::move(p);
+}
+
+bool program_buckets::empty() const { return programs.empty(); }
+
+std::size_t program_buckets::size() const { return programs.size(); }
+
+std::vector<std::size_t> program_buckets::get_batch_sizes() const
+{
+    std::vector<std::size_t> result;
+    std::transform(programs.begin(), programs.end(), std::back_inserter(result), [](auto&& pp) {
+        return pp.first;
+    });
+    return result;
+}
+
+program& program_buckets::get(std::size_t batch_size)
+{
+    auto it = programs.find(batch_size);
+    if(it == programs.end())
+        MIGRAPHX_THROW("PROGRAM_BUCKETS: No bucket for batch size " + std::to_string(batch_size));
+    return it->second;
+}
+
+const program& program_buckets::get(std::size_t batch_size) const
+{
+    auto it = programs.find(batch_size);
+    if(it == programs.end())
+        MIGRAPHX_THROW("PROGRAM_BUCKETS: No bucket for batch size " + std::to_string(batch_size));
+    return it->second;
+}
+
+std::size_t program_buckets::select(std::size_t batch_size) const
+{
+    auto it = programs.lower_bound(batch_size);
+    if(it == programs.end())
+        MIGRAPHX_THROW("PROGRAM_BUCKETS: Batch size " + std::to_string(batch_size) +
+                       " is larger than the largest bucket");
+    return it->first;
+}
+
+std::vector<std::string> program_buckets::get_batched_parameter_names() const
+{
+    std::vector<std::string> result;
+    if(programs.empty())
+        return result;
+    for(auto&& name : programs.begin()->second.get_parameter_names())
+    {
+        if(std::all_of(programs.begin(), programs.end(), [&](auto&& pp) {
+               auto pshapes = pp.second.get_parameter_shapes();
+               return contains(pshapes, name) and is_batched(pshapes.at(name), pp.first);
+           }))
+            result.push_back(name);
+    }
+    return result;
+}
+
+bool program_buckets::is_batched_output(std::size_t i) const
+{
+    return not programs.empty() and std::all_of(programs.begin(), programs.end(), [&](auto&& pp) {
+        auto output_shapes = pp.second.get_output_shapes();
+        return i < output_shapes.size() and is_batched(output_shapes[i], pp.first);
+    });
+}
+
+void program_buckets::share_literals()
+{
+    literal_pool pool;
+    for(auto&& pp : programs)
+    {
+        for(auto* m : pp.second.get_modules())
+        {
+            std::vector<std::pair<instruction_ref, literal>> shared;
+            for(auto ins : iterator_for(*m))
+            {
+                // Skip the last instruction since replacing it inserts an identity
+                if(ins->name() != "@literal" or ins == std::prev(m->end()))
+                    continue;
+                auto l = pool.add(ins->get_literal());
+                if(l.data() != ins->get_literal().data())
+                    shared.emplace_back(ins, l);
+            }
+            for(auto&& p : shared)
+            {
+                auto lit = m->move_instruction(m->add_literal(p.second), p.first);
+                m->replace_instruction(p.first, lit);
+                m->remove_instruction(p.first);
+            }
+        }
+    }
+}
+
+void program_buckets::compile(const target& t, compile_options options)
+{
+    for(auto&& pp : programs)
+        pp.second.compile(t, options);
+    this->share_literals();
+}
+
+std::vector<argument> program_buckets::eval(const parameter_map& params) const
+{
+    if(programs.empty())
+        MIGRAPHX_THROW("PROGRAM_BUCKETS: No programs to evaluate");
+    auto batched_names     = get_batched_parameter_names();
+    std::size_t batch_size = 0;
+    for(auto&& name : batched_names)
+    {
+        if(not contains(params, name))
+            continue;
+        auto n = params.at(name).get_shape().lens().front();
+        if(batch_size != 0 and n != batch_size)
+            MIGRAPHX_THROW("PROGRAM_BUCKETS: Mismatched batch size for parameter " + name);
+        batch_size = n;
+    }
+    if(batch_size == 0)
+        MIGRAPHX_THROW("PROGRAM_BUCKETS: No batched parameters are passed");
+
+    auto bucket      = select(batch_size);
+    const auto& prog = programs.at(bucket);
+    if(bucket == batch_size)
+        return prog.eval(params);
+
+    parameter_map padded;
+    for(auto&& pp : params)
+    {
+        if(contains(batched_names, pp.first))
+            padded[pp.first] = pad_batch(pp.second, prog.get_parameter_shape(pp.first));
+        else
+            padded[pp.first] = pp.second;
+    }
+    auto results = prog.eval(padded);
+    for(std::size_t i = 0; i < results.size(); i++)
+    {
+        if(is_batched_output(i))
+            results[i] = unpad_batch(results[i], batch_size);
+    }
+    return results;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -12,6 +12,7 @@
 #include <migraphx/stringutils.hpp>
 #include <migraphx/tf.hpp>
 #include <migraphx/onnx.hpp>
+#include <migraphx/program_buckets.hpp>
 #include <migraphx/type_name.hpp>
 #include <migraphx/load_save.hpp>
 #include <migraphx/register_target.hpp>
@@ -210,6 +211,19 @@ migraphx::shape to_shape(const py::buffer_info& info)
     }
 }
 
+migraphx::parameter_map to_parameter_map(const py::dict& params)
+{
+    migraphx::parameter_map pm;
+    for(auto x : params)
+    {
+        std::string key      = x.first.cast<std::string>();
+        py::buffer b         = x.second.cast<py::buffer>();
+        py::buffer_info info = b.request();
+        pm[key]              = migraphx::argument(to_shape(info), info.ptr);
+    }
+    return pm;
+}
+
 MIGRAPHX_PYBIND11_MODULE(migraphx, m)
 {
     py::class_<migraphx::shape>(m, "shape")
@@ -319,15 +333,7 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
             py::arg("name"))
         .def("run",
              [](migraphx::program& p, py::dict params) {
-                 migraphx::parameter_map pm;
-                 for(auto x : params)
-                 {
-                     std::string key      = x.first.cast<std::string>();
-                     py::buffer b         = x.second.cast<py::buffer>();
-                     py::buffer_info info = b.request();
-                     pm[key]              = migraphx::argument(to_shape(info), info.ptr);
-                 }
-                 return p.eval(pm);
+                 return p.eval(to_parameter_map(params));
              })
         .def("sort", &migraphx::program::sort)
         .def("print", [](const migraphx::program& p) { std::cout << p << std::endl; })
@@ -335,6 +341,31 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
         .def("__ne__", std::not_equal_to<migraphx::program>{})
         .def("__repr__", [](const migraphx::program& p) { return migraphx::to_string(p); });
 
+    py::class_<migraphx::program_buckets>(m, "program_buckets")
+        .def(py::init([]() { return migraphx::program_buckets(); }))
+        .def("insert", &migraphx::program_buckets::insert, py::arg("batch_size"), py::arg("p"))
+        .def("get_batch_sizes", &migraphx::program_buckets::get_batch_sizes)
+        .def("get_batched_parameter_names",
+             &migraphx::program_buckets::get_batched_parameter_names)
+        .def("select", &migraphx::program_buckets::select, py::arg("batch_size"))
+        .def(
+            "compile",
+            [](migraphx::program_buckets& p,
+               const migraphx::target& t,
+               bool offload_copy,
+               bool fast_math) {
+                migraphx::compile_options options;
+                options.offload_copy = offload_copy;
+                options.fast_math    = fast_math;
+                p.compile(t, options);
+            },
+            py::arg("t"),
+            py::arg("offload_copy") = true,
+            py::arg("fast_math")    = true)
+        .def("run", [](migraphx::program_buckets& p, py::dict params) {
+            return p.eval(to_parameter_map(params));
+        });
+
     py::class_<migraphx::operation>(m, "op")
         .def(py::init([](const std::string& name, py::kwargs kwargs) {
             migraphx::value v = migraphx::value::object{};
@@ -388,6 +419,26 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
         py::arg("print_program_on_error") = false,
         py::arg("max_loop_iterations")    = 10);
 
+    m.def(
+        "parse_onnx_buckets",
+        [](const std::string& filename,
+           std::vector<std::size_t> batch_sizes,
+           std::unordered_map<std::string, std::vector<std::size_t>> map_input_dims,
+           bool skip_unknown_operators,
+           int64_t max_loop_iterations) {
+            migraphx::onnx_options options;
+            options.map_input_dims         = map_input_dims;
+            options.skip_unknown_operators = skip_unknown_operators;
+            options.max_loop_iterations    = max_loop_iterations;
+            return migraphx::parse_onnx_buckets(filename, batch_sizes, options);
+        },
+        "Parse onnx file into a program for each batch size",
+        py::arg("filename"),
+        py::arg("batch_sizes"),
+        py::arg("map_input_dims") = std::unordered_map<std::string, std::vector<std::size_t>>(),
+        py::arg("skip_unknown_operators") = false,
+        py::arg("max_loop_iterations")    = 10);
+
     m.def(
         "parse_onnx_buffer",
         [](const std::string& onnx_buffer,
@@ -439,6 +490,29 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
           &migraphx::quantize_fp16,
           py::arg("prog"),
           py::arg("ins_names") = std::vector<std::string>{"all"});
+    // The plans are passed as JSON, so they can be saved and reused
+    m.def(
+        "search_fp16_plan",
+        [](const migraphx::program& p,
+           const migraphx::target& t,
+           const std::vector<migraphx::parameter_map>& calibration,
+           double error_budget,
+           const std::vector<std::string>& ins_names) {
+            return migraphx::to_json_string(
+                migraphx::search_fp16_plan(p, t, calibration, error_budget, ins_names));
+        },
+        py::arg("prog"),
+        py::arg("t"),
+        py::arg("calibration"),
+        py::arg("error_budget"),
+        py::arg("ins_names") = std::vector<std::string>{"all"});
+    m.def(
+        "quantize_fp16_plan",
+        [](migraphx::program& p, const std::string& plan) {
+            migraphx::quantize_fp16_plan(p, migraphx::from_json_string(plan));
+        },
+        py::arg("prog"),
+        py::arg("plan"));
     m.def("quantize_int8",
           &migraphx::quantize_int8,
           py::arg("prog"),
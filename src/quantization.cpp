@@ -1,8 +1,10 @@
 #include <migraphx/float_equal.hpp>
+#include <migraphx/generate.hpp>
 #include <migraphx/instruction_ref.hpp>
 #include <migraphx/quantization.hpp>
 #include <migraphx/quantize_fp16.hpp>
 #include <migraphx/quantize_int8.hpp>
+#include <migraphx/quantize_weights.hpp>
 #include <migraphx/simplify_reshapes.hpp>
 #include <migraphx/simplify_qdq.hpp>
 #include <migraphx/eliminate_common_subexpression.hpp>
@@ -16,7 +18,11 @@
 #include <migraphx/target.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/pass_manager.hpp>
+#include <migraphx/verify.hpp>
+#include <cmath>
+#include <limits>
 #include <set>
+#include <unordered_map>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -28,10 +34,10 @@ MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_INT8_QUANTIZATION_PARAMS)
 // For the conversion, there could be cases of overflowing, but it
 // is very rare in the area of deeping learning, so we just do a
 // truncate of the input to get the fp16.
-void quantize_fp16(program& prog, const std::vector<std::string>& ins_names)
+static void run_quantize_fp16(program& prog, const quantize_fp16_pass& qp)
 {
     run_passes(prog,
-               {quantize_fp16_pass{ins_names},
+               {qp,
                 eliminate_common_subexpression{},
                 dead_code_elimination{},
                 simplify_reshapes{},
@@ -40,6 +46,278 @@ void quantize_fp16(program& prog, const std::vector<std::string>& ins_names)
                 dead_code_elimination{}});
 }
 
+void quantize_fp16(program& prog, const std::vector<std::string>& ins_names)
+{
+    run_quantize_fp16(prog, quantize_fp16_pass{ins_names});
+}
+
+using fp16_indices = std::unordered_map<std::string, std::vector<std::size_t>>;
+
+// Runs the calibration data through the compiled program, and returns the outputs on the host
+static std::vector<std::vector<argument>>
+run_calibration(program prog,
+                const target& t,
+                const std::vector<parameter_map>& calibration,
+                const fp16_indices& indices)
+{
+    if(not indices.empty())
+        run_quantize_fp16(prog, quantize_fp16_pass{{}, indices});
+    prog.compile(t);
+    std::vector<std::vector<argument>> result;
+    for(auto&& arg : calibration)
+    {
+        parameter_map m;
+        for(auto&& x : prog.get_parameter_shapes())
+        {
+            if(arg.count(x.first) > 0)
+                m[x.first] = t.copy_to(arg.at(x.first));
+            else
+                m[x.first] = t.copy_to(generate_argument(x.second));
+        }
+        auto outputs = prog.eval(m);
+        std::transform(outputs.begin(), outputs.end(), outputs.begin(), [&](const auto& output) {
+            return t.copy_from(output);
+        });
+        result.push_back(outputs);
+    }
+    return result;
+}
+
+// The largest rms error of the outputs, where an overflow to inf or nan is an infinite error
+static double max_error(const std::vector<std::vector<argument>>& reference,
+                        const std::vector<std::vector<argument>>& results)
+{
+    double result = 0;
+    for(std::size_t i = 0; i < reference.size(); i++)
+    {
+        for(std::size_t j = 0; j < reference[i].size(); j++)
+        {
+            visit_all(reference[i][j], results[i][j])([&](auto x, auto y) {
+                auto error = rms_range(x, y);
+                if(not std::isfinite(error))
+                    error = std::numeric_limits<double>::infinity();
+                result = std::max(result, error);
+            });
+        }
+    }
+    return result;
+}
+
+// Instructions with a floating point output and input, which the conversion changes
+static bool is_fp16_candidate(const instruction& ins, const std::vector<std::string>& ins_names)
+{
+    if(not(contains(ins_names, ins.name()) or contains(ins_names, "all")))
+        return false;
+    if(starts_with(ins.name(), "@") or ins.name() == "convert")
+        return false;
+    auto is_float = [](const shape& s) {
+        return contains({shape::float_type, shape::double_type}, s.type());
+    };
+    return is_float(ins.get_shape()) and
+           std::any_of(ins.inputs().begin(), ins.inputs().end(), [&](auto input) {
+               return is_float(input->get_shape());
+           });
+}
+
+// The largest rms error of each pair of outputs, for the outputs of the instrumented program
+static std::vector<double> pair_errors(const std::vector<std::vector<argument>>& results,
+                                       std::size_t n)
+{
+    std::vector<double> result(n, 0);
+    for(const auto& outputs : results)
+    {
+        for(std::size_t i = 0; i < n; i++)
+        {
+            visit_all(outputs[i], outputs[n + i])([&](auto x, auto y) {
+                auto error = rms_range(x, y);
+                if(not std::isfinite(error))
+                    error = std::numeric_limits<double>::infinity();
+                result[i] = std::max(result[i], error);
+            });
+        }
+    }
+    return result;
+}
+
+// The error of converting each of the instructions of the main module to fp16 by itself, on its
+// own output. The program returns each instruction together with a copy of it that is computed in
+// fp16 from the same inputs, so a single compile measures the error of every instruction passed.
+static std::vector<double> fp16_instruction_errors(program prog,
+                                                   const target& t,
+                                                   const std::vector<parameter_map>& calibration,
+                                                   const std::vector<std::size_t>& indices)
+{
+    auto* mm = prog.get_main_module();
+    std::vector<instruction_ref> outputs;
+    std::transform(indices.begin(), indices.end(), std::back_inserter(outputs), [&](auto i) {
+        return std::next(mm->begin(), i);
+    });
+    std::vector<instruction_ref> copies;
+    for(auto ins : outputs)
+    {
+        auto inputs = ins->inputs();
+        std::transform(inputs.begin(), inputs.end(), inputs.begin(), [&](auto input) {
+            if(not contains({shape::float_type, shape::double_type}, input->get_shape().type()))
+                return input;
+            return mm->insert_instruction(
+                ins, make_op("convert", {{"target_type", shape::half_type}}), input);
+        });
+        auto half = mm->insert_instruction(std::next(ins), ins->get_operator(), inputs);
+        copies.push_back(mm->insert_instruction(
+            std::next(half), make_op("convert", {{"target_type", ins->get_shape().type()}}), half));
+    }
+    outputs.insert(outputs.end(), copies.begin(), copies.end());
+    mm->replace_return(outputs);
+    return pair_errors(run_calibration(prog, t, calibration, {}), indices.size());
+}
+
+value search_fp16_plan(const program& prog,
+                       const target& t,
+                       const std::vector<parameter_map>& calibration,
+                       double error_budget,
+                       const std::vector<std::string>& ins_names)
+{
+    if(calibration.empty())
+        MIGRAPHX_THROW("SEARCH_FP16_PLAN: no calibration data");
+    struct layer
+    {
+        std::string module_name;
+        std::size_t index;
+        std::string op;
+        double error;
+    };
+    std::vector<layer> layers;
+    for(const auto* m : prog.get_modules())
+    {
+        std::size_t index = 0;
+        for(const auto& ins : *m)
+        {
+            if(is_fp16_candidate(ins, ins_names))
+                layers.push_back({m->name(), index, ins.name(), 0});
+            index++;
+        }
+    }
+
+    auto reference = run_calibration(prog, t, calibration, {});
+    auto get_indices = [&](std::size_t n) {
+        fp16_indices result;
+        std::for_each(layers.begin(), layers.begin() + n, [&](const layer& l) {
+            result[l.module_name].push_back(l.index);
+        });
+        return result;
+    };
+    auto get_error = [&](std::size_t n) {
+        return max_error(reference, run_calibration(prog, t, calibration, get_indices(n)));
+    };
+
+    // The instructions of the main module are measured together, and the ones in submodules or
+    // with submodules, which are not returned by the main module, are each measured on the
+    // outputs of the program with a compile of their own
+    auto is_main = [&](const layer& l) {
+        return l.module_name == prog.get_main_module()->name() and
+               std::next(prog.get_main_module()->begin(), l.index)->module_inputs().empty();
+    };
+    std::vector<std::size_t> main_indices;
+    for(const auto& l : layers)
+    {
+        if(is_main(l))
+            main_indices.push_back(l.index);
+    }
+    // Every output keeps its buffer live and stops the target from fusing it, so the instructions
+    // are measured in batches to bound the memory and keep the program close to the real plan
+    const std::size_t batch_size = 16;
+    std::vector<double> main_errors;
+    for(std::size_t i = 0; i < main_indices.size(); i += batch_size)
+    {
+        std::vector<std::size_t> batch(main_indices.begin() + i,
+                                       main_indices.begin() +
+                                           std::min(main_indices.size(), i + batch_size));
+        auto errors = fp16_instruction_errors(prog, t, calibration, batch);
+        main_errors.insert(main_errors.end(), errors.begin(), errors.end());
+    }
+    auto main_error  = main_errors.begin();
+    for(auto& l : layers)
+    {
+        if(is_main(l))
+            l.error = *main_error++;
+        else
+            l.error = max_error(
+                reference, run_calibration(prog, t, calibration, {{l.module_name, {l.index}}}));
+    }
+    std::stable_sort(layers.begin(), layers.end(), [](const layer& x, const layer& y) {
+        return x.error < y.error;
+    });
+
+    // The errors of the instructions by themselves only rank them, since the errors of the main
+    // module are on their own outputs rather than on the outputs of the program. Only the errors
+    // on the outputs are compared with the budget, where the largest number of the least
+    // sensitive instructions within the budget is found with a binary search, as converting more
+    // instructions rarely reduces the error. This compiles the program about log2 of the number
+    // of instructions times.
+    std::size_t hi = layers.size();
+    std::size_t lo = 0;
+    double error   = 0;
+    while(lo < hi)
+    {
+        auto mid = (lo + hi + 1) / 2;
+        auto e   = get_error(mid);
+        if(e <= error_budget)
+        {
+            lo    = mid;
+            error = e;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
+
+    value converted = value::array{};
+    value kept      = value::array{};
+    for(std::size_t i = 0; i < layers.size(); i++)
+    {
+        const auto& l = layers[i];
+        (i < lo ? converted : kept)
+            .push_back({{"module", l.module_name},
+                        {"index", l.index},
+                        {"operator", l.op},
+                        {"error", l.error}});
+    }
+    return {{"error_budget", error_budget},
+            {"error", error},
+            {"converted", converted},
+            {"kept", kept}};
+}
+
+void quantize_fp16_plan(program& prog, const value& plan)
+{
+    auto modules = prog.get_modules();
+    fp16_indices indices;
+    for(auto&& x : plan.at("converted"))
+    {
+        auto name  = x.at("module").to<std::string>();
+        auto index = x.at("index").to<std::size_t>();
+        auto op    = x.at("operator").to<std::string>();
+        auto it    = std::find_if(
+            modules.begin(), modules.end(), [&](const module* m) { return m->name() == name; });
+        if(it == modules.end())
+            MIGRAPHX_THROW("QUANTIZE_FP16_PLAN: no module " + name);
+        const auto* m = *it;
+        if(index >= m->size())
+            MIGRAPHX_THROW("QUANTIZE_FP16_PLAN: no instruction " + std::to_string(index) +
+                           " in module " + name);
+        // The plan was searched on a different program
+        auto ins = std::next(m->begin(), index);
+        if(ins->name() != op)
+            MIGRAPHX_THROW("QUANTIZE_FP16_PLAN: instruction " + std::to_string(index) +
+                           " in module " + name + " is " + ins->name() + " instead of " + op);
+        indices[name].push_back(index);
+    }
+    if(indices.empty())
+        return;
+    run_quantize_fp16(prog, quantize_fp16_pass{{}, indices});
+}
+
 void quantize_int8(program& prog,
                    const target& t,
                    const std::vector<parameter_map>& calibration,
@@ -134,5 +412,12 @@ void quantize_int8(program& prog,
                 dead_code_elimination{}});
 }
 
+// Only the constant weights of the dot instructions are quantized, so the memory of the weights
+// is reduced while the activations keep their floating-point type
+void quantize_weights(program& prog, std::size_t bits, std::size_t group_size)
+{
+    run_passes(prog, {quantize_weights_pass{bits, group_size}, dead_code_elimination{}});
+}
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
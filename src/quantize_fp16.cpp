@@ -1,3 +1,4 @@
+#include <migraphx/errors.hpp>
 #include <migraphx/float_equal.hpp>
 #include <migraphx/instruction_ref.hpp>
 #include <migraphx/quantize_fp16.hpp>
@@ -12,6 +13,39 @@
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+static void quantize_instruction(module& m, instruction_ref ins)
+{
+    // skip return and convert instructions
+    if(contains({"@return", "convert"}, ins->name()))
+        return;
+
+    if(ins->inputs().empty())
+        return;
+
+    auto mod_inputs = ins->module_inputs();
+    auto s          = ins->get_shape();
+    // Convert back to original type before quantizing the inputs
+    if(mod_inputs.empty())
+    {
+        auto r = m.insert_instruction(
+            std::next(ins), make_op("convert", {{"target_type", s.type()}}), ins);
+        m.replace_instruction(ins, r);
+    }
+
+    // Convert each of the inputs that are floating point to fp16
+    auto inputs = ins->inputs();
+    std::transform(inputs.begin(), inputs.end(), inputs.begin(), [&](auto input) {
+        auto input_type = input->get_shape().type();
+        if(input_type != shape::float_type and input_type != shape::double_type)
+            return input;
+        return m.insert_instruction(
+            ins, make_op("convert", {{"target_type", shape::half_type}}), input);
+    });
+
+    // Replace inputs
+    m.replace_instruction(ins, ins->get_operator(), inputs, mod_inputs);
+}
+
 static void quantize_module(module& m, const std::vector<std::string>& ins_names)
 {
     for(auto ins : iterator_for(m))
@@ -19,40 +53,32 @@ static void quantize_module(module& m, const std::vector<std::string>& ins_names
         // instructions are not in the set to be quantized
         if(not(contains(ins_names, ins->name()) or contains(ins_names, "all")))
             continue;
-
-        // skip return and convert instructions
-        if(contains({"@return", "convert"}, ins->name()))
-            continue;
-
-        if(ins->inputs().empty())
-            continue;
-
-        auto mod_inputs = ins->module_inputs();
-        auto s          = ins->get_shape();
-        // Convert back to original type before quantizing the inputs
-        if(mod_inputs.empty())
-        {
-            auto r = m.insert_instruction(
-                std::next(ins), make_op("convert", {{"target_type", s.type()}}), ins);
-            m.replace_instruction(ins, r);
-        }
-
-        // Convert each of the inputs that are floating point to fp16
-        auto inputs = ins->inputs();
-        std::transform(inputs.begin(), inputs.end(), inputs.begin(), [&](auto input) {
-            auto input_type = input->get_shape().type();
-            if(input_type != shape::float_type and input_type != shape::double_type)
-                return input;
-            return m.insert_instruction(
-                ins, make_op("convert", {{"target_type", shape::half_type}}), input);
-        });
-
-        // Replace inputs
-        m.replace_instruction(ins, ins->get_operator(), inputs, mod_inputs);
+        quantize_instruction(m, ins);
     }
 }
 
-void quantize_fp16_pass::apply(module& m) const { quantize_module(m, ins_names); }
+void quantize_fp16_pass::apply(module& m) const
+{
+    if(ins_indices.empty())
+    {
+        quantize_module(m, ins_names);
+        return;
+    }
+    auto it = ins_indices.find(m.name());
+    if(it == ins_indices.end())
+        return;
+    // The positions are looked up before any convert is inserted
+    std::vector<instruction_ref> instructions;
+    for(auto i : it->second)
+    {
+        if(i >= m.size())
+            MIGRAPHX_THROW("QUANTIZE_FP16: no instruction " + std::to_string(i) + " in module " +
+                           m.name());
+        instructions.push_back(std::next(m.begin(), i));
+    }
+    for(auto ins : instructions)
+        quantize_instruction(m, ins);
+}
 
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
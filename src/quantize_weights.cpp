@@ -0,0 +1,91 @@
+#include <migraphx/quantize_weights.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/op/dequant_dot.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// The weights of a dot are broadcasted to the batch dimensions of the other input
+static instruction_ref get_weights(instruction_ref ins)
+{
+    if(ins->name() == "multibroadcast" and ins->inputs().front()->get_shape().lens().size() == 2)
+        return ins->inputs().front();
+    return ins;
+}
+
+static literal pack_int4(const std::vector<std::int8_t>& q, std::size_t k, std::size_t n)
+{
+    auto kp = op::dequant_dot::packed_size(k, 4);
+    std::vector<std::uint8_t> packed(n * kp, 0);
+    for(std::size_t col = 0; col < n; col++)
+    {
+        for(std::size_t j = 0; j < k; j++)
+        {
+            auto nibble = static_cast<std::uint8_t>(q[col * k + j] & 0x0f);
+            packed[col * kp + j / 2] |= (j % 2 == 0) ? nibble : (nibble << 4u);
+        }
+    }
+    return literal{{shape::uint8_type, {n, kp}}, packed};
+}
+
+void quantize_weights_pass::apply(module& m) const
+{
+    if(bits != 8 and bits != 4)
+        MIGRAPHX_THROW("QUANTIZE_WEIGHTS: only 8 and 4 bits are supported");
+    op::dequant_dot op{bits, group_size};
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "dot")
+            continue;
+        auto a = ins->inputs().front();
+        auto w = get_weights(ins->inputs().back());
+        auto t = a->get_shape().type();
+        if(not contains({shape::float_type, shape::half_type, shape::double_type}, t))
+            continue;
+        if(w->get_shape().lens().size() != 2 or not w->can_eval())
+            continue;
+        auto weights = w->eval();
+        if(weights.empty())
+            continue;
+        auto k      = w->get_shape().lens().front();
+        auto n      = w->get_shape().lens().back();
+        auto group  = group_size == 0 ? k : group_size;
+        auto ngroup = op.groups(k);
+        float qmax  = (1u << (bits - 1)) - 1;
+        // The weights are stored transposed, so each column is contiguous
+        std::vector<std::int8_t> q(n * k);
+        std::vector<float> scales(n * ngroup);
+        weights.visit([&](auto x) {
+            par_for(scales.size(), [&](auto i) {
+                auto col     = i / ngroup;
+                auto start   = (i % ngroup) * group;
+                auto last    = std::min(k, start + group);
+                float maxabs = 0;
+                for(auto j = start; j < last; j++)
+                    maxabs = std::max(maxabs, std::fabs(static_cast<float>(x(j, col))));
+                // Groups of zeros are not scaled
+                float scale = maxabs == 0 ? 1 : maxabs / qmax;
+                scales[i]   = scale;
+                for(auto j = start; j < last; j++)
+                {
+                    auto r         = std::round(static_cast<float>(x(j, col)) / scale);
+                    q[col * k + j] = static_cast<std::int8_t>(std::max(-qmax, std::min(qmax, r)));
+                }
+            });
+        });
+        auto qweights = bits == 8 ? literal{{shape::int8_type, {n, k}}, q} : pack_int4(q, k, n);
+        auto qw       = m.add_literal(qweights);
+        auto s        = m.add_literal(literal{{t, {n, ngroup}}, scales});
+        m.replace_instruction(ins, op, a, qw, s);
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,267 @@
+#include <migraphx/request_batcher.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/errors.hpp>
+#include <cstring>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+double request_batcher_stats::average_latency() const
+{
+    if(requests == 0)
+        return 0;
+    return total_latency / requests;
+}
+
+double request_batcher_stats::average_batch_size() const
+{
+    if(batches == 0)
+        return 0;
+    return double(samples) / batches;
+}
+
+double request_batcher_stats::throughput() const
+{
+    if(elapsed <= 0)
+        return 0;
+    return samples * 1000.0 / elapsed;
+}
+
+static double to_ms(std::chrono::steady_clock::duration d)
+{
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+// A view of the samples [start, start+n) of the argument that shares its data
+static argument slice_batch(const argument& arg, std::size_t start, std::size_t n)
+{
+    const auto& s = arg.get_shape();
+    auto lens     = s.lens();
+    lens.front()  = n;
+    auto offset   = start * s.strides().front() * s.type_size();
+    auto a        = arg.share();
+    return {shape{s.type(), lens, s.strides()}, [=] { return a.data() + offset; }};
+}
+
+static argument concat_batch(const std::vector<argument>& args)
+{
+    const auto& s = args.front().get_shape();
+    auto lens     = s.lens();
+    lens.front()  = std::accumulate(args.begin(), args.end(), std::size_t{0}, [](auto n, auto&& a) {
+        return n + a.get_shape().lens().front();
+    });
+    argument result{shape{s.type(), lens}};
+    std::size_t start = 0;
+    for(auto&& arg : args)
+    {
+        const auto& alens = arg.get_shape().lens();
+        if(alens.size() != lens.size() or
+           not std::equal(alens.begin() + 1, alens.end(), lens.begin() + 1))
+            MIGRAPHX_THROW("REQUEST_BATCHER: Cannot batch argument " + to_string(arg.get_shape()) +
+                           " with " + to_string(s));
+        visit_all(slice_batch(result, start, alens.front()), arg)([&](auto output, auto input) {
+            std::copy(input.begin(), input.end(), output.begin());
+        });
+        start += alens.front();
+    }
+    return result;
+}
+
+static bool same_argument(const argument& x, const argument& y)
+{
+    if(x.get_shape() != y.get_shape())
+        return false;
+    if(x.data() == y.data())
+        return true;
+    return std::memcmp(x.data(), y.data(), x.get_shape().bytes()) == 0;
+}
+
+request_batcher::request_batcher(program_buckets b, request_batcher_options options)
+    : buckets(std::move(b)),
+      batched_names(buckets.get_batched_parameter_names()),
+      max_batch_size(options.max_batch_size),
+      max_delay(options.max_delay)
+{
+    if(buckets.empty())
+        MIGRAPHX_THROW("REQUEST_BATCHER: No programs to evaluate");
+    if(batched_names.empty())
+        MIGRAPHX_THROW("REQUEST_BATCHER: Programs have no batched parameters");
+    auto largest = buckets.get_batch_sizes().back();
+    if(max_batch_size == 0)
+        max_batch_size = largest;
+    if(max_batch_size > largest)
+        MIGRAPHX_THROW("REQUEST_BATCHER: Max batch size " + std::to_string(max_batch_size) +
+                       " is larger than the largest bucket");
+    auto noutputs = buckets.get(largest).get_output_shapes().size();
+    for(std::size_t i = 0; i < noutputs; i++)
+        batched_outputs.push_back(buckets.is_batched_output(i));
+    worker = joinable_thread([this] { this->process(); });
+}
+
+request_batcher::~request_batcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+    }
+    cv.notify_all();
+    worker.join();
+}
+
+std::future<std::vector<argument>> request_batcher::submit(parameter_map params)
+{
+    std::size_t batch_size = 0;
+    for(auto&& name : batched_names)
+    {
+        if(not contains(params, name))
+            MIGRAPHX_THROW("REQUEST_BATCHER: Missing batched parameter " + name);
+        auto n = params.at(name).get_shape().lens().front();
+        if(batch_size != 0 and n != batch_size)
+            MIGRAPHX_THROW("REQUEST_BATCHER: Mismatched batch size for parameter " + name);
+        batch_size = n;
+    }
+    if(batch_size == 0 or batch_size > max_batch_size)
+        MIGRAPHX_THROW("REQUEST_BATCHER: Invalid batch size " + std::to_string(batch_size));
+
+    request r;
+    r.params     = std::move(params);
+    r.batch_size = batch_size;
+    r.submitted  = clock::now();
+    auto result  = r.result.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(stopped)
+            MIGRAPHX_THROW("REQUEST_BATCHER: Request submitted after stopping");
+        if(first_submit == clock::time_point{})
+            first_submit = r.submitted;
+        queued_samples += batch_size;
+        queue.push_back(std::move(r));
+    }
+    cv.notify_all();
+    return result;
+}
+
+request_batcher_stats request_batcher::get_stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+bool request_batcher::same_unbatched(const request& x, const request& y) const
+{
+    if(x.params.size() != y.params.size())
+        return false;
+    return std::all_of(x.params.begin(), x.params.end(), [&](auto&& p) {
+        if(contains(batched_names, p.first))
+            return true;
+        auto it = y.params.find(p.first);
+        return it != y.params.end() and same_argument(p.second, it->second);
+    });
+}
+
+std::pair<std::size_t, std::size_t> request_batcher::next_batch() const
+{
+    std::size_t count = 0;
+    std::size_t n     = 0;
+    for(auto&& r : queue)
+    {
+        if(n + r.batch_size > max_batch_size or not same_unbatched(queue.front(), r))
+            break;
+        n += r.batch_size;
+        count++;
+    }
+    return {count, n};
+}
+
+void request_batcher::process()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for(;;)
+    {
+        cv.wait(lock, [&] { return stopped or not queue.empty(); });
+        // Only return once every queued request has been evaluated
+        if(queue.empty())
+            return;
+        // Stop waiting once the batch is full or a queued request cannot join it
+        cv.wait_until(lock, queue.front().submitted + max_delay, [&] {
+            auto next = next_batch();
+            return stopped or next.first < queue.size() or next.second >= max_batch_size;
+        });
+        auto next = next_batch();
+        std::vector<request> batch;
+        std::move(queue.begin(), queue.begin() + next.first, std::back_inserter(batch));
+        queue.erase(queue.begin(), queue.begin() + next.first);
+        queued_samples -= next.second;
+        lock.unlock();
+        run_batch(std::move(batch));
+        lock.lock();
+    }
+}
+
+void request_batcher::run_batch(std::vector<request> batch)
+{
+    auto started = clock::now();
+    try
+    {
+        auto params = batch.front().params;
+        if(batch.size() > 1)
+        {
+            for(auto&& name : batched_names)
+            {
+                std::vector<argument> args;
+                std::transform(batch.begin(),
+                               batch.end(),
+                               std::back_inserter(args),
+                               [&](const request& r) { return r.params.at(name); });
+                params[name] = concat_batch(args);
+            }
+        }
+        auto results  = buckets.eval(params);
+        auto finished = clock::now();
+
+        std::vector<std::vector<argument>> outputs;
+        std::size_t start = 0;
+        for(auto&& r : batch)
+        {
+            std::vector<argument> output;
+            for(std::size_t i = 0; i < results.size(); i++)
+            {
+                if(i < batched_outputs.size() and batched_outputs[i])
+                    output.push_back(slice_batch(results[i], start, r.batch_size));
+                else
+                    output.push_back(results[i]);
+            }
+            outputs.push_back(std::move(output));
+            start += r.batch_size;
+        }
+
+        // Update the stats before completing the requests so they are visible to the callers
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.requests += batch.size();
+            stats.batches++;
+            stats.samples += start;
+            stats.padded_samples += buckets.select(start);
+            for(auto&& r : batch)
+            {
+                auto latency = to_ms(finished - r.submitted);
+                stats.total_latency += latency;
+                stats.max_latency = std::max(stats.max_latency, latency);
+                stats.total_queue_time += to_ms(started - r.submitted);
+            }
+            stats.elapsed = to_ms(finished - first_submit);
+        }
+        for(std::size_t i = 0; i < batch.size(); i++)
+            batch[i].result.set_value(std::move(outputs[i]));
+    }
+    catch(...)
+    {
+        for(auto&& r : batch)
+            r.result.set_exception(std::current_exception());
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -41,11 +41,18 @@ struct stream_info
     std::unordered_map<instruction_ref, std::size_t> weights;
     std::unordered_map<instruction_ref, std::size_t> iweights;
     ins_dep_map mod_implicit_deps;
+    // Branches with a weight at most this are not split into their own streams. The weights of the
+    // schedule model are small integers, while the weights of a cost model are in microseconds.
+    std::size_t min_partition_threshold = 2;
 
     void calc_implicit_deps(const module& m) { mod_implicit_deps = m.calc_implicit_deps(); }
 
-    void accumulate_weights(instruction_ref last, const schedule_model& model)
+    void accumulate_weights(instruction_ref last,
+                            const schedule_model& model,
+                            const cost_model& cost)
     {
+        if(not cost.empty())
+            min_partition_threshold = cost.partition_threshold();
         fix<std::size_t>([&](auto self, auto ins) -> std::size_t {
             if(not contains(weights, ins))
             {
@@ -53,6 +60,8 @@ struct stream_info
                 auto&& op          = ins->get_operator();
                 if(not is_context_free(op) and op.name()[0] != '@')
                     weight = model.weight(op);
+                if(weight > 0 and not cost.empty())
+                    weight = cost.weight(ins);
                 // This will ensure a stream will be assigned to return
                 if(op.name() == "@return")
                     weight = 1;
@@ -91,7 +100,6 @@ struct stream_info
             return args.end();
         }
 
-        const std::size_t min_partition_threshold = 2;
         sort_args_by_weight(args, std::greater<>{});
 
         auto it = std::lower_bound(std::next(args.begin()),
@@ -515,7 +523,7 @@ void schedule::apply(module& m) const
     stream_info si;
     si.calc_implicit_deps(m);
     auto last = std::prev(m.end());
-    si.accumulate_weights(last, model);
+    si.accumulate_weights(last, model, cost);
     auto nstreams = si.assign_streams(m, model.concurrency());
     si.sort(m, model.concurrency());
 
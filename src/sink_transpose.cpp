@@ -0,0 +1,212 @@
+#include <migraphx/sink_transpose.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/matcher.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/op/transpose.hpp>
+#include <migraphx/permutation.hpp>
+#include <migraphx/ranges.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static std::vector<int64_t> get_permutation(instruction_ref ins)
+{
+    return any_cast<const op::transpose&>(ins->get_operator()).dims;
+}
+
+static bool is_identity(const std::vector<int64_t>& perm)
+{
+    return std::is_sorted(perm.begin(), perm.end());
+}
+
+static std::int64_t normalize_axis(std::int64_t axis, std::size_t rank)
+{
+    return axis < 0 ? axis + static_cast<std::int64_t>(rank) : axis;
+}
+
+MIGRAPHX_PRED_MATCHER(sinkable_transpose, instruction_ref ins)
+{
+    return ins->name() == "transpose" and ins->outputs().size() == 1;
+}
+
+// The outputs of the module keep their layout, so nothing is moved past them
+static bool is_output(const module& m, instruction_ref ins)
+{
+    return ins == std::prev(m.end()) or
+           std::any_of(ins->outputs().begin(), ins->outputs().end(), [](auto output) {
+               return output->name() == "@return";
+           });
+}
+
+// Moving the transpose must not make the tensor that is transposed larger
+static bool can_sink(const module& m, instruction_ref ins, instruction_ref transpose)
+{
+    return not is_output(m, ins) and
+           ins->get_shape().elements() <= transpose->get_shape().elements();
+}
+
+// Computes the operator on the inputs of the transposes, and transposes the result
+static void sink(module& m,
+                 instruction_ref ins,
+                 const operation& op,
+                 const std::vector<instruction_ref>& inputs,
+                 const std::vector<int64_t>& perm)
+{
+    auto x = m.insert_instruction(ins, op, inputs);
+    m.replace_instruction(ins, make_op("transpose", {{"permutation", perm}}), x);
+}
+
+// Inputs that can be transposed back without any cost, since they are constant or broadcasted
+static bool is_cheap_to_transpose(instruction_ref ins)
+{
+    return ins->can_eval() or ins->get_shape().broadcasted() or ins->get_shape().scalar();
+}
+
+struct find_pointwise
+{
+    auto matcher() const
+    {
+        return match::has_attribute("pointwise")(
+            match::any_of[match::inputs()](sinkable_transpose().bind("transpose")));
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins       = r.result;
+        auto transpose = r.instructions["transpose"];
+        if(not can_sink(m, ins, transpose))
+            return;
+        auto perm   = get_permutation(transpose);
+        auto iperm  = invert_permutation(perm);
+        auto inputs = ins->inputs();
+        for(auto& input : inputs)
+        {
+            if(input->name() == "transpose" and input->outputs().size() == 1 and
+               get_permutation(input) == perm)
+                input = input->inputs().front();
+            else if(is_cheap_to_transpose(input))
+                input = m.insert_instruction(
+                    ins, make_op("transpose", {{"permutation", iperm}}), input);
+            else
+                return;
+        }
+        sink(m, ins, ins->get_operator(), inputs, perm);
+    }
+};
+
+struct find_reduce
+{
+    auto matcher() const
+    {
+        return match::name(
+            "reduce_sum", "reduce_mean", "reduce_max", "reduce_min", "reduce_prod")(
+            match::arg(0)(sinkable_transpose().bind("transpose")));
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins       = r.result;
+        auto transpose = r.instructions["transpose"];
+        if(not can_sink(m, ins, transpose))
+            return;
+        auto perm = get_permutation(transpose);
+        auto v    = ins->get_operator().to_value();
+        std::vector<int64_t> axes;
+        for(auto axis : v.at("axes").to_vector<int64_t>())
+            axes.push_back(perm[normalize_axis(axis, perm.size())]);
+        v["axes"] = axes;
+        sink(m, ins, make_op(ins->name(), v), transpose->inputs(), perm);
+    }
+};
+
+struct find_slice
+{
+    auto matcher() const
+    {
+        return match::name("slice")(match::arg(0)(sinkable_transpose().bind("transpose")));
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins       = r.result;
+        auto transpose = r.instructions["transpose"];
+        if(not can_sink(m, ins, transpose))
+            return;
+        auto perm = get_permutation(transpose);
+        auto v    = ins->get_operator().to_value();
+        std::vector<int64_t> axes;
+        for(auto axis : v.at("axes").to_vector<int64_t>())
+            axes.push_back(perm[normalize_axis(axis, perm.size())]);
+        v["axes"] = axes;
+        sink(m, ins, make_op("slice", v), transpose->inputs(), perm);
+    }
+};
+
+struct find_concat
+{
+    auto matcher() const
+    {
+        return match::name("concat")(match::all_of[match::inputs()](sinkable_transpose()));
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins  = r.result;
+        auto perm = get_permutation(ins->inputs().front());
+        if(is_output(m, ins))
+            return;
+        if(std::any_of(ins->inputs().begin(), ins->inputs().end(), [&](auto input) {
+               return get_permutation(input) != perm;
+           }))
+            return;
+        auto v    = ins->get_operator().to_value();
+        auto axis = normalize_axis(v.at("axis").to<int64_t>(), perm.size());
+        v["axis"] = perm[axis];
+        std::vector<instruction_ref> inputs;
+        std::transform(ins->inputs().begin(),
+                       ins->inputs().end(),
+                       std::back_inserter(inputs),
+                       [](auto input) { return input->inputs().front(); });
+        sink(m, ins, make_op("concat", v), inputs, perm);
+    }
+};
+
+// Merges a transpose of a transpose, which removes both when one is the inverse of the other
+struct find_nested_transpose
+{
+    auto matcher() const
+    {
+        return match::name("transpose")(match::arg(0)(sinkable_transpose().bind("inner")));
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins   = r.result;
+        auto inner = r.instructions["inner"];
+        auto perm  = reorder_dims(get_permutation(inner), get_permutation(ins));
+        if(is_identity(perm))
+            m.replace_instruction(ins, inner->inputs().front());
+        else
+            m.replace_instruction(
+                ins, make_op("transpose", {{"permutation", perm}}), inner->inputs().front());
+    }
+};
+
+void sink_transpose::apply(module& m) const
+{
+    for(int i = 0; i < 2; i++)
+    {
+        match::find_matches(m,
+                            find_nested_transpose{},
+                            find_pointwise{},
+                            find_reduce{},
+                            find_slice{},
+                            find_concat{});
+        dead_code_elimination{}.apply(m);
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
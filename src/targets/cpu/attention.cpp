@@ -0,0 +1,204 @@
+#include <migraphx/config.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/register_op.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+// Strides of the last two dimensions along with the offset of each batch
+struct attention_matrix
+{
+    const float* data      = nullptr;
+    std::size_t row_stride = 0;
+    std::size_t col_stride = 0;
+    shape batch_shape;
+
+    attention_matrix(const argument& arg)
+        : data(reinterpret_cast<const float*>(arg.data())),
+          row_stride(*(arg.get_shape().strides().end() - 2)),
+          col_stride(arg.get_shape().strides().back())
+    {
+        const auto& s = arg.get_shape();
+        std::vector<std::size_t> lens(s.lens().begin(), s.lens().end() - 2);
+        std::vector<std::size_t> strides(s.strides().begin(), s.strides().end() - 2);
+        if(not lens.empty())
+            batch_shape = shape{s.type(), lens, strides};
+    }
+
+    const float* batch(std::size_t b) const
+    {
+        if(batch_shape.lens().empty())
+            return data;
+        return data + batch_shape.index(b);
+    }
+};
+
+/**
+ * Computes `softmax(dot(q, k) * scale + mask) * v` with the softmax over the last axis, where
+ * the mask is optional. The scores are computed for a block of rows and columns at a time and
+ * the softmax is computed online, by rescaling the partial sums whenever the running maximum of a
+ * row changes, so the full score matrix is never written to memory.
+ */
+struct cpu_attention : auto_register_op<cpu_attention>
+{
+    float scale = 1.0f;
+
+    // Number of rows of q processed together, so the packed blocks of k and v are reused
+    static constexpr std::size_t row_block = 32;
+    // Number of columns of k and rows of v packed into a block that fits in the cache
+    static constexpr std::size_t col_block = 64;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.scale, "scale"));
+    }
+
+    std::string name() const { return "cpu::attention"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        // Compensate for allocation
+        inputs.pop_back();
+        check_shapes{inputs, *this}.has(3, 4).same_type().same_ndims().min_ndims(2);
+        const auto& q = inputs[0].lens();
+        const auto& k = inputs[1].lens();
+        const auto& v = inputs[2].lens();
+        auto n        = q.size();
+        if(inputs[0].type() != shape::float_type)
+            MIGRAPHX_THROW("ATTENTION: only float is supported");
+        if(not std::equal(q.begin(), q.end() - 2, k.begin()) or
+           not std::equal(q.begin(), q.end() - 2, v.begin()))
+            MIGRAPHX_THROW("ATTENTION: batch dimensions do not match");
+        if(q[n - 1] != k[n - 2] or k[n - 1] != v[n - 2])
+            MIGRAPHX_THROW("ATTENTION: inner dimensions do not match");
+        auto out_lens = q;
+        if(inputs.size() == 4)
+        {
+            auto score_lens   = q;
+            score_lens[n - 1] = k[n - 1];
+            if(inputs[3].lens() != score_lens)
+                MIGRAPHX_THROW("ATTENTION: mask dimensions do not match the scores");
+        }
+        out_lens[n - 1] = v[n - 1];
+        return {inputs[0].type(), out_lens};
+    }
+
+    argument compute(context& ctx, const shape& output_shape, std::vector<argument> args) const
+    {
+        auto result = args.back();
+        auto n      = output_shape.lens().size();
+        auto m      = output_shape.lens()[n - 2];
+        auto dv     = output_shape.lens()[n - 1];
+        auto d      = args[0].get_shape().lens()[n - 1];
+        auto ncols  = args[1].get_shape().lens()[n - 1];
+        if(output_shape.elements() == 0)
+            return result;
+        auto batches  = output_shape.elements() / (m * dv);
+        auto blocks   = (m + row_block - 1) / row_block;
+        bool has_mask = args.size() == 5;
+        auto* output  = reinterpret_cast<float*>(result.data());
+        attention_matrix q{args[0]};
+        attention_matrix k{args[1]};
+        attention_matrix v{args[2]};
+        attention_matrix mask = has_mask ? attention_matrix{args[3]} : q;
+        float s               = scale;
+
+        ctx.bulk_execute(batches * blocks, 1, [&](auto start, auto end) {
+            std::vector<float> qt(row_block * d);
+            std::vector<float> kt(col_block * d);
+            std::vector<float> vt(col_block * dv);
+            std::vector<float> scores(row_block * col_block);
+            std::vector<float> acc(row_block * dv);
+            std::vector<float> row_max(row_block);
+            std::vector<float> row_sum(row_block);
+            for(auto i = start; i < end; i++)
+            {
+                auto b     = i / blocks;
+                auto r0    = (i % blocks) * row_block;
+                auto rows  = std::min(row_block, m - r0);
+                auto* qb   = q.batch(b);
+                auto* kb   = k.batch(b);
+                auto* vb   = v.batch(b);
+                auto* mb   = mask.batch(b);
+                auto* outb = output + b * m * dv;
+                for(std::size_t r = 0; r < rows; r++)
+                    for(std::size_t c = 0; c < d; c++)
+                        qt[r * d + c] = qb[(r0 + r) * q.row_stride + c * q.col_stride];
+                std::fill(acc.begin(), acc.end(), 0.0f);
+                std::fill(row_max.begin(), row_max.end(), -std::numeric_limits<float>::infinity());
+                std::fill(row_sum.begin(), row_sum.end(), 0.0f);
+                for(std::size_t c0 = 0; c0 < ncols; c0 += col_block)
+                {
+                    auto cols = std::min(col_block, ncols - c0);
+                    // Pack the block of k transposed and of v, so the inner loops are contiguous
+                    for(std::size_t j = 0; j < cols; j++)
+                    {
+                        for(std::size_t c = 0; c < d; c++)
+                            kt[j * d + c] = kb[c * k.row_stride + (c0 + j) * k.col_stride];
+                        for(std::size_t c = 0; c < dv; c++)
+                            vt[j * dv + c] = vb[(c0 + j) * v.row_stride + c * v.col_stride];
+                    }
+                    for(std::size_t r = 0; r < rows; r++)
+                    {
+                        const auto* qr = qt.data() + r * d;
+                        auto* sr       = scores.data() + r * col_block;
+                        float bmax     = -std::numeric_limits<float>::infinity();
+                        for(std::size_t j = 0; j < cols; j++)
+                        {
+                            const auto* kj = kt.data() + j * d;
+                            float x        = 0;
+                            for(std::size_t c = 0; c < d; c++)
+                                x += qr[c] * kj[c];
+                            x *= s;
+                            if(has_mask)
+                                x += mb[(r0 + r) * mask.row_stride + (c0 + j) * mask.col_stride];
+                            sr[j] = x;
+                            bmax  = std::max(bmax, x);
+                        }
+                        auto new_max = std::max(row_max[r], bmax);
+                        // Every score so far is -inf, so there is nothing to accumulate
+                        if(std::isinf(new_max) and new_max < 0)
+                            continue;
+                        auto* ar        = acc.data() + r * dv;
+                        auto correction = std::exp(row_max[r] - new_max);
+                        row_sum[r] *= correction;
+                        for(std::size_t c = 0; c < dv; c++)
+                            ar[c] *= correction;
+                        for(std::size_t j = 0; j < cols; j++)
+                        {
+                            auto p = std::exp(sr[j] - new_max);
+                            row_sum[r] += p;
+                            const auto* vj = vt.data() + j * dv;
+                            for(std::size_t c = 0; c < dv; c++)
+                                ar[c] += p * vj[c];
+                        }
+                        row_max[r] = new_max;
+                    }
+                }
+                for(std::size_t r = 0; r < rows; r++)
+                {
+                    auto* ar = acc.data() + r * dv;
+                    for(std::size_t c = 0; c < dv; c++)
+                        outb[(r0 + r) * dv + c] = ar[c] / row_sum[r];
+                }
+            }
+        });
+        return result;
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,67 @@
+#include <migraphx/cpu/context.hpp>
+#include <cstring>
+#include <iostream>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+void context::pin_threads() const
+{
+    // The cpus the team of this thread is pinned to. It is kept for each thread, so the threads
+    // running programs at the same time do not share it.
+    thread_local std::vector<std::size_t> pinned_cpus;
+    if(pinned_cpus == cpus)
+        return;
+    pinned_cpus = cpus;
+#ifndef MIGRAPHX_DISABLE_OMP
+    // The threads of the team are reused by the later parallel regions started from this thread.
+    // Thread 0 is the calling thread, which keeps the affinity it was given by the application
+    // outside of the regions.
+    const auto n = cpus.size();
+#pragma omp parallel num_threads(n)
+    {
+        const std::size_t i = omp_get_thread_num();
+        if(i > 0)
+            pin_thread(cpus[i]);
+    }
+#else
+    // The threads are created for each parallel_for, so there is no worker to pin
+    static const bool warned = [] {
+        std::cerr << "WARNING: MIGRAPHX_CPU_NUMA_POLICY is ignored, since the cpu target is built "
+                     "without OpenMP"
+                  << std::endl;
+        return true;
+    }();
+    (void)warned;
+#endif
+}
+
+value context::to_value() const { return {{"numa_policy", to_string(policy)}}; }
+
+void context::from_value(const value& v)
+{
+    if(not v.contains("numa_policy"))
+        return;
+    policy = to_numa_policy(v.at("numa_policy").to<std::string>());
+    cpus   = get_numa_cpus(policy);
+}
+
+void context::first_touch(const argument& arg)
+{
+    if(policy == numa_policy::none or arg.empty())
+        return;
+    auto* data  = arg.data();
+    auto nbytes = arg.get_shape().bytes();
+    // Split the buffer by pages, since the node of a page is decided by its first write
+    const std::size_t page = 4096;
+    this->bulk_execute((nbytes + page - 1) / page, 1, [&](auto start, auto end) {
+        auto first = start * page;
+        auto last  = std::min(nbytes, end * page);
+        std::memset(data + first, 0, last - first);
+    });
+}
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -9,6 +9,16 @@ namespace cpu {
 struct dnnl_deconvolution
     : dnnl_extend_op<dnnl_deconvolution, dnnl::deconvolution_forward, op::deconvolution>
 {
+    std::string algo = "deconvolution_direct";
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack_join(self.reflect_base(self, f),
+                         migraphx::reflect(self.op, f),
+                         pack(f(self.algo, "algo")));
+    }
+
     std::vector<int> arg_map(int) const
     {
         return {MIGRAPHX_DNNL_PREFIX(ARG_SRC), MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS)};
@@ -37,7 +47,7 @@ struct dnnl_deconvolution
         std::transform(
             dilation.begin(), dilation.end(), dilation.begin(), [](auto x) { return x - 1; });
         return {dnnl::prop_kind::forward_inference,
-                dnnl::algorithm::deconvolution_direct,
+                to_dnnl_algo(algo),
                 m.at(MIGRAPHX_DNNL_PREFIX(ARG_SRC)),
                 m.at(MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS)),
                 m.at(MIGRAPHX_DNNL_PREFIX(ARG_DST)),
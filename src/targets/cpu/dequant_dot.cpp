@@ -0,0 +1,145 @@
+#include <migraphx/config.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/op/dequant_dot.hpp>
+#include <migraphx/register_op.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+// Sums the products in independent lanes, since the compiler only vectorizes a float sum when
+// it may reorder it
+static float dot_product(const float* x, const float* y, std::size_t n)
+{
+    constexpr std::size_t lanes = 16;
+    std::array<float, lanes> sums{};
+    std::size_t i = 0;
+    for(; i + lanes <= n; i += lanes)
+    {
+        for(std::size_t l = 0; l < lanes; l++)
+            sums[l] += x[i + l] * y[i + l];
+    }
+    float result = std::accumulate(sums.begin(), sums.end(), 0.0f);
+    for(; i < n; i++)
+        result += x[i] * y[i];
+    return result;
+}
+
+// Converts a column of packed 4-bit weights to float, shifting each nibble to the top of a byte
+// and back to extend the sign, so the loop has no branches
+static void unpack_int4(const std::int8_t* x, std::size_t k, float* y)
+{
+    for(std::size_t i = 0; i < k / 2; i++)
+    {
+        y[2 * i]     = static_cast<std::int8_t>(x[i] * 16) >> 4;
+        y[2 * i + 1] = x[i] >> 4;
+    }
+    if(k % 2 != 0)
+        y[k - 1] = static_cast<std::int8_t>(x[k / 2] * 16) >> 4;
+}
+
+/**
+ * Computes a dequant_dot on float for a block of rows of `a` and a few columns of weights at a
+ * time. Each column is read contiguously from the quantized weights and converted to float once
+ * for all the rows of the block, and the scale is applied to the sum of each group instead of to
+ * each weight, so only the quantized bytes are streamed from memory.
+ */
+struct cpu_dequant_dot : auto_register_op<cpu_dequant_dot>
+{
+    op::dequant_dot op;
+
+    // Number of rows of a that reuse each converted group of weights
+    static constexpr std::size_t row_block = 8;
+    // Number of columns computed by a task, to give each thread a few pages of weights
+    static constexpr std::size_t col_block = 8;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::reflect(self.op, f);
+    }
+
+    std::string name() const { return "cpu::dequant_dot"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        // Compensate for allocation
+        inputs.pop_back();
+        check_shapes(inputs, *this).standard();
+        auto result = migraphx::compute_shape(op, inputs);
+        if(result.type() != shape::float_type)
+            MIGRAPHX_THROW("DEQUANT_DOT: only float is supported");
+        return result;
+    }
+
+    argument
+    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
+    {
+        auto result = args.back();
+        if(output_shape.elements() == 0)
+            return result;
+        auto k             = args[0].get_shape().lens().back();
+        auto n             = output_shape.lens().back();
+        auto m             = output_shape.elements() / n;
+        auto kp            = op::dequant_dot::packed_size(k, op.bits);
+        auto group         = op.group_size == 0 ? k : op.group_size;
+        auto ngroup        = op.groups(k);
+        auto col_blocks    = (n + col_block - 1) / col_block;
+        auto row_blocks    = (m + row_block - 1) / row_block;
+        bool int4          = op.bits == 4;
+        const auto* a      = reinterpret_cast<const float*>(args[0].data());
+        const auto* b      = reinterpret_cast<const std::int8_t*>(args[1].data());
+        const auto* scales = reinterpret_cast<const float*>(args[2].data());
+        auto* output       = reinterpret_cast<float*>(result.data());
+
+        ctx.bulk_execute(row_blocks * col_blocks, 1, [&](auto start, auto end) {
+            std::vector<float> w(k);
+            for(auto i = start; i < end; i++)
+            {
+                auto r0   = (i / col_blocks) * row_block;
+                auto c0   = (i % col_blocks) * col_block;
+                auto rows = std::min(row_block, m - r0);
+                auto cols = std::min(col_block, n - c0);
+                for(auto col = c0; col < c0 + cols; col++)
+                {
+                    const auto* column = b + col * kp;
+                    if(int4)
+                        unpack_int4(column, k, w.data());
+                    else
+                        std::copy(column, column + k, w.begin());
+                    std::array<float, row_block> acc{};
+                    for(std::size_t g = 0; g < ngroup; g++)
+                    {
+                        auto j0     = g * group;
+                        auto len    = std::min(group, k - j0);
+                        float scale = scales[col * ngroup + g];
+                        for(std::size_t r = 0; r < rows; r++)
+                        {
+                            const auto* x = a + (r0 + r) * k + j0;
+                            acc[r] += dot_product(x, w.data() + j0, len) * scale;
+                        }
+                    }
+                    for(std::size_t r = 0; r < rows; r++)
+                        output[(r0 + r) * n + col] = acc[r];
+                }
+            }
+        });
+        return result;
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
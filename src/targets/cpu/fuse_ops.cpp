@@ -12,36 +12,17 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
-MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_DNNL_POST_OPS_WORKAROUND);
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_DNNL_POST_OPS);
 
-MIGRAPHX_PRED_MATCHER(has_post_ops, instruction_ref ins)
+static bool has_post_ops(instruction_ref ins)
 {
     auto v = ins->get_operator().to_value();
     return v.contains("post_ops");
 }
 
-MIGRAPHX_PRED_MATCHER(without_post_ops, instruction_ref ins)
+static bool is_commutative(const std::string& algo)
 {
-    auto v = ins->get_operator().to_value();
-    return v.contains("post_ops") and v["post_ops"].empty();
-}
-
-bool workaround_dnnl_broken_post_ops(const operation& op, const operation& post_op)
-{
-    if(contains({"dnnl::dot", "dnnl::convolution"}, op.name()))
-        return true;
-    auto pv = post_op.to_value();
-    if(not pv.at("post_ops").empty())
-        return true;
-    auto v         = op.to_value();
-    auto last_op   = v.at("post_ops").empty() ? v : v.at("post_ops").back();
-    auto algo      = last_op.contains("algo") ? last_op.at("algo").to<std::string>() : op.name();
-    auto post_algo = pv["algo"].to<std::string>();
-    if(starts_with(algo, "eltwise") and starts_with(post_algo, "eltwise"))
-        return true;
-    if(algo == post_algo)
-        return true;
-    return false;
+    return contains({"binary_add", "binary_mul", "binary_max", "binary_min"}, algo);
 }
 
 operation merge_post_ops(const operation& op, const operation& post_op)
@@ -57,34 +38,80 @@ operation merge_post_ops(const operation& op, const operation& post_op)
     return make_op(op.name(), v);
 }
 
+// The sum can be written in place when nothing else uses the buffer it was written to
+static bool can_sum_in_place(instruction_ref sum)
+{
+    if(sum->outputs().size() != 1)
+        return false;
+    auto alloc = instruction::get_output_alias(sum, true);
+    return alloc != sum and alloc->name() == "cpu::allocate" and alloc->outputs().size() == 1;
+}
+
+// The first binary add with the layout of the output is already accumulated as a sum, see
+// get_sum_post_op_arg
+static bool has_sum_post_op(instruction_ref ins)
+{
+    std::vector<std::string> algos;
+    for(const auto& po : ins->get_operator().to_value().at("post_ops"))
+    {
+        auto algo = po.at("algo").to<std::string>();
+        if(contains(algo, "binary"))
+            algos.push_back(algo);
+    }
+    auto args = ins->inputs().end() - 1 - algos.size();
+    return std::any_of(algos.begin(), algos.end(), [&](const auto& algo) {
+        auto arg = *(args++);
+        return contains(algo, "binary_add") and arg->get_shape() == ins->get_shape();
+    });
+}
+
 struct find_post_ops
 {
     context* ctx = nullptr;
-    match::any_matcher matcher() const
+    auto matcher() const { return match::name("dnnl::eltwise", "dnnl::binary"); }
+
+    // The input that the post op can be merged into, which is the end of the inputs when there
+    // is none
+    static auto find_input(instruction_ref ins)
     {
-        if(enabled(MIGRAPHX_DISABLE_DNNL_POST_OPS_WORKAROUND{}))
-            return match::name("dnnl::eltwise",
-                               "dnnl::binary")(match::arg(0)(has_post_ops(), match::used_once()));
-        else
-            return match::name("dnnl::eltwise")(
-                without_post_ops(),
-                match::arg(0)(match::name("dnnl::binary")(without_post_ops(), match::used_once())));
+        const auto& inputs = ins->inputs();
+        auto last          = inputs.begin() + (ins->name() == "dnnl::binary" ? 2 : 1);
+        if(ins->name() == "dnnl::binary" and
+           (inputs[0] == inputs[1] or
+            not is_commutative(ins->get_operator().to_value()["algo"].to<std::string>())))
+            last = inputs.begin() + 1;
+        auto it = std::find_if(inputs.begin(), last, [&](auto input) {
+            return has_post_ops(input) and input->outputs().size() == 1;
+        });
+        return it == last ? inputs.end() : it;
     }
 
     void apply(module& m, const match::matcher_result& r) const
     {
-        auto ins   = r.result;
-        auto x_ins = ins->inputs().front();
-        auto x     = x_ins->get_operator();
-
-        if(workaround_dnnl_broken_post_ops(x, ins->get_operator()))
+        auto ins  = r.result;
+        auto post = ins->get_operator();
+        // Post ops with their own post ops are merged first
+        if(not post.to_value().at("post_ops").empty())
+            return;
+        auto it = find_input(ins);
+        if(it == ins->inputs().end())
             return;
+        auto x_ins = *it;
+        auto op    = merge_post_ops(x_ins->get_operator(), post);
 
-        auto op       = merge_post_ops(x, ins->get_operator());
         auto inputs   = x_ins->inputs();
         inputs.back() = ins->inputs().back();
         if(ins->name() == "dnnl::binary")
-            inputs.insert(std::prev(inputs.end()), ins->inputs().at(1));
+        {
+            auto other = ins->inputs().at(it == ins->inputs().begin() ? 1 : 0);
+            inputs.insert(std::prev(inputs.end()), other);
+            // A residual add is accumulated directly into the buffer of the residual, unless an
+            // earlier residual is already the sum
+            if(other->get_shape() == ins->get_shape() and can_sum_in_place(other) and
+               starts_with(post.to_value()["algo"].to<std::string>(), "binary_add") and
+               not has_sum_post_op(x_ins))
+                inputs.back() = other;
+        }
         auto input_shapes = to_shapes(inputs);
         auto new_shape    = try_compute_shape(op, input_shapes);
         if(new_shape.empty() or new_shape.front() != ins->get_shape())
@@ -98,6 +125,8 @@ struct find_post_ops
 
 void fuse_ops::apply(module& m) const
 {
+    if(enabled(MIGRAPHX_DISABLE_DNNL_POST_OPS{}))
+        return;
     for(std::size_t i = 0; i < 4; i++)
     {
         match::find_matches(m, find_post_ops{ctx});
@@ -2,11 +2,55 @@
 #include <migraphx/context.hpp>
 #include <migraphx/cpu/context.hpp>
 #include <migraphx/op/gather.hpp>
+#include <migraphx/op/gathernd.hpp>
+#include <cstring>
+#include <functional>
+#include <numeric>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
+// Tables larger than this are unlikely to be in the cache, so the rows are prefetched
+static const std::size_t prefetch_threshold = 1024 * 1024 * 4;
+// Number of rows to prefetch ahead of the row being copied
+static const std::size_t prefetch_distance = 8;
+
+template <class Iterator>
+static std::size_t product(Iterator start, Iterator last)
+{
+    return std::accumulate(start, last, std::size_t{1}, std::multiplies<>{});
+}
+
+static void prefetch_row(const char* row, std::size_t row_bytes)
+{
+    for(std::size_t i = 0; i < row_bytes; i += 64)
+        __builtin_prefetch(row + i);
+}
+
+// Copy whole rows from the offsets of the data, since gather and gathernd on standard shapes
+// only ever copy contiguous blocks of the data
+static void copy_rows(context& ctx,
+                      const argument& output,
+                      const argument& data,
+                      const std::vector<std::size_t>& offsets,
+                      std::size_t row_bytes)
+{
+    auto* output_ptr     = output.data();
+    const auto* data_ptr = data.data();
+    bool prefetch        = data.get_shape().bytes() > prefetch_threshold;
+    // Give each thread at least a few pages to copy
+    auto grain = std::max<std::size_t>(1, 16384 / std::max<std::size_t>(row_bytes, 1));
+    ctx.bulk_execute(offsets.size(), grain, [&](auto start, auto end) {
+        for(auto i = start; i < end; i++)
+        {
+            if(prefetch and i + prefetch_distance < end)
+                prefetch_row(data_ptr + offsets[i + prefetch_distance], row_bytes);
+            std::memcpy(output_ptr + i * row_bytes, data_ptr + offsets[i], row_bytes);
+        }
+    });
+}
+
 struct cpu_gather : auto_register_op<cpu_gather>
 {
     op::gather op;
@@ -28,29 +72,103 @@ struct cpu_gather : auto_register_op<cpu_gather>
     argument
     compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
     {
-        std::size_t nelements = output_shape.elements();
-        auto lens             = args[0].get_shape().lens();
-        auto axis_dim_size    = lens[op.axis];
-        lens[op.axis]         = args[1].get_shape().elements();
-        shape out_comp{output_shape.type(), lens};
-
-        visit_all(args.back(), args[0])([&](auto output, auto input) {
-            args[1].visit([&](auto indices) {
-                const auto* indices_ptr = indices.data();
-                auto* output_ptr        = output.data();
-                ctx.bulk_execute(nelements, 1024, [=](auto start, auto end) {
-                    for(auto i = start; i < end; i++)
-                    {
-                        auto idx      = out_comp.multi(i);
-                        auto in_index = indices_ptr[idx[op.axis]];
-                        in_index      = (in_index < 0) ? in_index + axis_dim_size : in_index;
-                        idx[op.axis]  = in_index;
-                        output_ptr[i] = input(idx.begin(), idx.end());
-                    }
-                });
+        if(output_shape.elements() == 0)
+            return args.back();
+        const auto& lens   = args[0].get_shape().lens();
+        auto axis_dim_size = static_cast<int64_t>(lens[op.axis]);
+        auto outer         = product(lens.begin(), lens.begin() + op.axis);
+        auto inner         = product(lens.begin() + op.axis + 1, lens.end());
+        auto row_bytes     = inner * output_shape.type_size();
+        auto nindices      = args[1].get_shape().elements();
+
+        std::vector<std::size_t> indices(nindices);
+        args[1].visit([&](auto idx) {
+            std::transform(idx.begin(), idx.end(), indices.begin(), [&](auto i) -> std::size_t {
+                auto in_index = static_cast<int64_t>(i);
+                if(in_index < -axis_dim_size or in_index >= axis_dim_size)
+                    MIGRAPHX_THROW("GATHER: index " + std::to_string(in_index) +
+                                   " is out of bounds");
+                return (in_index < 0) ? in_index + axis_dim_size : in_index;
             });
         });
 
+        std::vector<std::size_t> offsets(outer * nindices);
+        for(std::size_t i = 0; i < offsets.size(); i++)
+            offsets[i] = ((i / nindices) * lens[op.axis] + indices[i % nindices]) * row_bytes;
+        copy_rows(ctx, args.back(), args[0], offsets, row_bytes);
+        return args.back();
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+struct cpu_gathernd : auto_register_op<cpu_gathernd>
+{
+    op::gathernd op;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::reflect(self.op, f);
+    }
+    std::string name() const { return "cpu::" + op.name(); }
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        // Compensate for allocation
+        inputs.pop_back();
+        check_shapes(inputs, *this).standard();
+        return migraphx::compute_shape(op, inputs);
+    }
+
+    argument
+    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
+    {
+        if(output_shape.elements() == 0)
+            return args.back();
+        const auto& data_lens    = args[0].get_shape().lens();
+        const auto& indices_lens = args[1].get_shape().lens();
+        auto batch_dims          = static_cast<std::size_t>(op.batch_dims);
+        auto k                   = indices_lens.back();
+        auto num_slices          = product(indices_lens.begin(), indices_lens.end() - 1);
+        auto slice_size          = product(data_lens.begin() + batch_dims + k, data_lens.end());
+        auto num_batches         = product(data_lens.begin(), data_lens.begin() + batch_dims);
+        auto batch_stride        = product(data_lens.begin() + batch_dims, data_lens.end());
+        auto slices_per_batch    = num_slices / num_batches;
+        auto row_bytes           = slice_size * output_shape.type_size();
+
+        // Number of elements skipped by incrementing the index of each dimension of a slice
+        std::vector<std::size_t> slice_strides(k);
+        std::size_t running_product = slice_size;
+        for(std::size_t i = k; i > 0; i--)
+        {
+            slice_strides[i - 1] = running_product;
+            running_product *= data_lens[batch_dims + i - 1];
+        }
+
+        std::vector<std::size_t> offsets(num_slices);
+        args[1].visit([&](auto indices) {
+            for(std::size_t i = 0; i < num_slices; i++)
+            {
+                std::size_t offset = (i / slices_per_batch) * batch_stride;
+                for(std::size_t j = 0; j < k; j++)
+                {
+                    auto dim_len = static_cast<int64_t>(data_lens[batch_dims + j]);
+                    auto index   = static_cast<int64_t>(indices[i * k + j]);
+                    if(index < -dim_len or index >= dim_len)
+                        MIGRAPHX_THROW("GATHERND: index " + std::to_string(index) +
+                                       " is out of bounds for dim of len " +
+                                       std::to_string(dim_len));
+                    if(index < 0)
+                        index += dim_len;
+                    offset += index * slice_strides[j];
+                }
+                offsets[i] = offset * output_shape.type_size();
+            }
+        });
+        copy_rows(ctx, args.back(), args[0], offsets, row_bytes);
         return args.back();
     }
 
@@ -0,0 +1,32 @@
+#ifndef MIGRAPHX_GUARD_AMDMIGRAPHX_CPU_CONCAT_CPU_OPT_HPP
+#define MIGRAPHX_GUARD_AMDMIGRAPHX_CPU_CONCAT_CPU_OPT_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/operation.hpp>
+#include <migraphx/op/concat.hpp>
+#include <string>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+struct concat_cpu_optimization
+{
+    std::string name() const { return "dnnl::concat"; }
+    std::string allocate() const { return "cpu::allocate"; }
+    op::concat get_concat(const operation& op) const
+    {
+        op::concat result;
+        result.axis = op.to_value().at("axis").to<int64_t>();
+        return result;
+    }
+    // The dnnl operators write with the strides of their allocation
+    bool supports_strided() const { return true; }
+};
+
+} // namespace cpu
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
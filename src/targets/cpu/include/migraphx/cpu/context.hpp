@@ -2,9 +2,12 @@
 #define MIGRAPHX_GUARD_RTGLIB_CONTEXT_HPP
 
 #include <migraphx/config.hpp>
+#include <migraphx/argument.hpp>
 #include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/cpu/numa.hpp>
 #include <migraphx/cpu/parallel.hpp>
 #include <migraphx/par_for.hpp>
+#include <migraphx/value.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -12,12 +15,39 @@ namespace cpu {
 
 struct context
 {
+    numa_policy policy            = get_numa_policy();
+    std::vector<std::size_t> cpus = get_numa_cpus(policy);
+
     void finish() const {}
 
+    std::size_t max_threads() const { return cpus.empty() ? cpu::max_threads() : cpus.size(); }
+
+    // Pins the worker threads to their cpus, once for each thread that runs the program. The
+    // calling thread itself is only pinned while it runs a parallel region, see bulk_execute.
+    void pin_threads() const;
+
+    // The numa policy, which can be set when compiling with compile_options::context
+    value to_value() const;
+    void from_value(const value& v);
+
+    // Writes the buffer from the worker threads, so its pages are allocated on their nodes
+    void first_touch(const argument& arg);
+
     template <class F>
     void bulk_execute(std::size_t n, std::size_t min_grain, F f)
     {
-        cpu::parallel_for(n, min_grain, f);
+        if(cpus.empty())
+        {
+            cpu::parallel_for(n, min_grain, this->max_threads(), f);
+            return;
+        }
+        pin_threads();
+#ifndef MIGRAPHX_DISABLE_OMP
+        // The calling thread runs the first chunk, which also touches the pages of the buffers
+        // written by the first_touch, so it is kept on the first cpu for the region
+        scoped_pin pin{cpus.front()};
+#endif
+        cpu::parallel_for(n, min_grain, this->max_threads(), f);
     }
 
     template <class F>
@@ -7,6 +7,7 @@
 #include <migraphx/register_op.hpp>
 #include <migraphx/check_shapes.hpp>
 #include <unordered_map>
+#include <cstring>
 #include <migraphx/errors.hpp>
 #include <migraphx/assert.hpp>
 #ifdef MIGRAPHX_ENABLE_ZENDNN
@@ -210,19 +211,28 @@ struct dnnl_op : auto_register_op<Derived>
         }
         return result;
     }
+    // The first binary add with the same memory layout as the destination is appended as a sum,
+    // which accumulates into the values already in the destination
+    int get_sum_post_op_arg(const std::unordered_map<int, dnnl::memory::desc>& m) const
+    {
+        int result = -1;
+        for_each_post_op([&](auto&& op, auto arg) {
+            if(result < 0 and contains(op.algo, "binary_add") and
+               m.at(arg) == m.at(MIGRAPHX_DNNL_PREFIX(ARG_DST)))
+                result = static_cast<int>(arg);
+        });
+        return result;
+    }
     dnnl::primitive_attr
     get_primitive_attr(const std::unordered_map<int, dnnl::memory::desc>& m) const
     {
         dnnl::primitive_attr result;
         dnnl::post_ops po;
+        auto sum_arg = get_sum_post_op_arg(m);
         for_each_post_op([&](auto&& op, auto arg) {
-            if(contains(op.algo, "binary_add"))
+            if(contains(op.algo, "binary_add") and static_cast<int>(arg) == sum_arg)
             {
-                auto desc = m.at(arg);
-                if(desc == m.at(MIGRAPHX_DNNL_PREFIX(ARG_DST)))
-                    po.append_sum(1.0f);
-                else
-                    po.append_binary(to_dnnl_algo(op.algo), m.at(arg));
+                po.append_sum(1.0f);
             }
             else if(contains(op.algo, "binary"))
             {
@@ -278,6 +288,10 @@ struct dnnl_op : auto_register_op<Derived>
         auto md          = to_memory_desc(output_shape, inputs);
         auto prim        = get_primitive(md);
         auto arg_lookup  = create_arg_map(inputs.size());
+        // Index of the input appended as a sum, which is the number of inputs when there is none
+        std::size_t sum_input =
+            std::find(arg_lookup.begin(), arg_lookup.end(), get_sum_post_op_arg(md)) -
+            arg_lookup.begin();
 #ifndef NDEBUG
         auto prim_attr = get_primitive_attr(md);
 #endif
@@ -330,6 +344,7 @@ struct dnnl_op : auto_register_op<Derived>
                     {
                         pos.get_params_sum(i, scale);
                         algo = dnnl::algorithm::binary_add;
+                        j++;
                     }
                     else
                     {
@@ -345,6 +360,12 @@ struct dnnl_op : auto_register_op<Derived>
                 }
             }
 #endif
+            // The sum is added to the destination, so it is copied there unless it is computed in
+            // place
+            if(sum_input < args.size() - 1 and args[sum_input].data() != args.back().data())
+                std::memcpy(args.back().data(),
+                            args[sum_input].data(),
+                            md.at(MIGRAPHX_DNNL_PREFIX(ARG_DST)).get_size());
             std::unordered_map<int, dnnl::memory> m;
             m[MIGRAPHX_DNNL_PREFIX(ARG_DST)] =
                 to_dnnl_memory(md.at(MIGRAPHX_DNNL_PREFIX(ARG_DST)), args.back());
@@ -379,10 +400,19 @@ struct dnnl_extend_op : dnnl_op<Derived, Primitive>
     shape compute_shape(std::vector<shape> inputs) const
     {
         const auto& self = static_cast<const Derived&>(*this);
+        auto alloc       = inputs.back();
         // Compensate for allocation
         inputs.pop_back();
-        self.required(check_shapes(inputs, self));
+        self.required(check_shapes(this->trim_post_op_inputs(inputs), self));
         auto r = migraphx::compute_shape(op, this->trim_post_op_inputs(inputs));
+        // Write with the strides of the allocation, such as a slice of a concat, as long as dnnl
+        // has an optimized implementation for it
+        if(alloc != r and alloc.type() == r.type() and alloc.lens() == r.lens())
+        {
+            auto prim = this->get_primitive(this->to_memory_desc(alloc, inputs));
+            if(not starts_with(this->impl(prim), "ref:"))
+                return alloc;
+        }
         // Call to get_primitive to make sure an algo is available
         this->get_primitive(this->to_memory_desc(r, inputs));
         return r;
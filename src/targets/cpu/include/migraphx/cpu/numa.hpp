@@ -0,0 +1,71 @@
+#ifndef MIGRAPHX_GUARD_CPU_NUMA_HPP
+#define MIGRAPHX_GUARD_CPU_NUMA_HPP
+
+#include <migraphx/config.hpp>
+#include <sched.h>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+/**
+ * How the worker threads of the cpu target are placed on the NUMA nodes of the host, selected
+ * with MIGRAPHX_CPU_NUMA_POLICY, or for one compile with the `numa_policy` of
+ * `compile_options::context`:
+ *
+ * - `none` leaves the threads to the scheduler, which is the default.
+ * - `spread` pins one worker to each cpu, alternating between the nodes, so the bandwidth of
+ *   every node is used and the scratch memory is spread over the nodes that touch it.
+ * - `local` pins the workers to the cpus of the node in MIGRAPHX_CPU_NUMA_NODE, and gives the
+ *   program its own copy of the literals on that node. Compiling one program for each node gives
+ *   every node its own replica of the weights.
+ */
+enum class numa_policy
+{
+    none,
+    spread,
+    local
+};
+
+std::string to_string(numa_policy policy);
+numa_policy to_numa_policy(const std::string& name);
+
+// Reads the policy from MIGRAPHX_CPU_NUMA_POLICY
+numa_policy get_numa_policy();
+
+// Parses a cpu list from sysfs, such as "0-3,8-11"
+std::vector<std::size_t> parse_cpu_list(const std::string& s);
+
+// The cpus of each NUMA node that this process is allowed to run on
+std::vector<std::vector<std::size_t>> get_numa_nodes();
+
+// The cpu each worker thread is pinned to, which is empty when the threads are not pinned. The
+// `local` policy uses the cpus of `node`.
+std::vector<std::size_t> get_numa_cpus(numa_policy policy,
+                                       const std::vector<std::vector<std::size_t>>& nodes,
+                                       std::size_t node);
+// Uses the nodes of the host, and the node in MIGRAPHX_CPU_NUMA_NODE
+std::vector<std::size_t> get_numa_cpus(numa_policy policy);
+
+// Pins the calling thread to the cpu
+void pin_thread(std::size_t cpu);
+
+// Pins the calling thread to the cpu until it is destroyed, and then restores its affinity
+struct scoped_pin
+{
+    explicit scoped_pin(std::size_t cpu);
+    scoped_pin(const scoped_pin&) = delete;
+    scoped_pin& operator=(const scoped_pin&) = delete;
+    ~scoped_pin();
+
+    private:
+    cpu_set_t affinity;
+    bool restore = false;
+};
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_CPU_NUMA_HPP
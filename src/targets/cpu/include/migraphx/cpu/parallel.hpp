@@ -78,12 +78,18 @@ void parallel_for_impl(std::size_t n, std::size_t threadsize, F f)
 }
 #endif
 template <class F>
-void parallel_for(std::size_t n, std::size_t min_grain, F f)
+void parallel_for(std::size_t n, std::size_t min_grain, std::size_t nthreads, F f)
 {
-    const auto threadsize = std::min<std::size_t>(max_threads(), n / min_grain);
+    const auto threadsize = std::min<std::size_t>(nthreads, n / min_grain);
     parallel_for_impl(n, threadsize, f);
 }
 
+template <class F>
+void parallel_for(std::size_t n, std::size_t min_grain, F f)
+{
+    parallel_for(n, min_grain, max_threads(), f);
+}
+
 template <class F>
 void parallel_for(std::size_t n, F f)
 {
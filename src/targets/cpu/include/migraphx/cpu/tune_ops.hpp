@@ -0,0 +1,44 @@
+#ifndef MIGRAPHX_GUARD_CPU_TUNE_OPS_HPP
+#define MIGRAPHX_GUARD_CPU_TUNE_OPS_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/instruction_ref.hpp>
+#include <string>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct module;
+
+namespace cpu {
+
+struct context;
+
+// The entries of the tuning database are only valid for the same version of dnnl on the same
+// instruction set, so they are grouped by this key
+std::string tuning_db_key();
+
+// The operator, its attributes other than the algorithm, and the input shapes, as JSON
+std::string problem_key(instruction_ref ins);
+
+/**
+ * Selects the dnnl algorithm for each convolution and deconvolution. With `tune` set, every
+ * candidate algorithm is benchmarked for each problem, and the fastest is saved to the tuning
+ * database in `db_file`, so later compiles reuse it without tuning again. The target sets them
+ * from MIGRAPHX_CPU_TUNE and MIGRAPHX_CPU_TUNING_DB.
+ */
+struct tune_ops
+{
+    context* ctx = nullptr;
+    // Benchmarks the problems that are not in the database
+    bool tune = false;
+    // The tuning database, which is not read or written when it is empty
+    std::string db_file = {};
+    std::string name() const { return "cpu::tune_ops"; }
+    void apply(module& m) const;
+};
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_CPU_TUNE_OPS_HPP
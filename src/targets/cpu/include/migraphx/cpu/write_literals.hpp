@@ -9,8 +9,16 @@ inline namespace MIGRAPHX_INLINE_NS {
 struct module;
 namespace cpu {
 
+struct context;
+
+/**
+ * Replaces the literals with `cpu::literal`. The buffers of the literals are shared, unless the
+ * context pins its threads to a NUMA node, in which case the program gets its own copy of the
+ * literals on that node.
+ */
 struct write_literals
 {
+    context* ctx = nullptr;
     std::string name() const { return "cpu::write_literals"; }
     void apply(module& m) const;
 };
@@ -1,5 +1,7 @@
 #include <migraphx/config.hpp>
 #include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <cmath>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -32,11 +34,113 @@ struct dnnl_layernorm : dnnl_op<dnnl_layernorm, dnnl::layer_normalization_forwar
     {
         return {dnnl::prop_kind::forward_inference,
                 m.at(MIGRAPHX_DNNL_PREFIX(ARG_SRC)),
-                1e-12f,
+                epsilon,
                 dnnl::normalization_flags::none};
     }
 };
 
+// Whether the value of the shape only depends on the index of the last dimension
+static bool is_row_broadcast(const shape& s)
+{
+    return std::all_of(s.strides().begin(), s.strides().end() - 1, [](auto x) { return x == 0; });
+}
+
+/**
+ * Normalizes the last dimension of the input. With `residual` the first two inputs are added
+ * together before being normalized, and with `affine` the normalized values are multiplied by
+ * the second to last input and added to the last input, which are broadcasted along the rows.
+ * Every row is read from memory and written back once.
+ */
+struct cpu_layernorm : auto_register_op<cpu_layernorm>
+{
+    float epsilon = 1e-12f;
+    bool residual = false;
+    bool affine   = false;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.epsilon, "epsilon"),
+                    f(self.residual, "residual"),
+                    f(self.affine, "affine"));
+    }
+
+    std::string name() const { return "cpu::layernorm"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        // Compensate for allocation
+        inputs.pop_back();
+        std::size_t n = 1 + (residual ? 1 : 0) + (affine ? 2 : 0);
+        check_shapes{inputs, *this}.has(n).same_type().same_dims().min_ndims(1);
+        auto s = inputs.front();
+        if(s.type() != shape::float_type)
+            MIGRAPHX_THROW("LAYERNORM: only float is supported");
+        auto nnormalized = residual ? 2 : 1;
+        check_shapes{inputs.data(), inputs.data() + nnormalized, *this}.standard();
+        if(affine and not std::all_of(inputs.end() - 2, inputs.end(), &is_row_broadcast))
+            MIGRAPHX_THROW("LAYERNORM: scale and shift must be broadcasted along the rows");
+        return s;
+    }
+
+    argument compute(context& ctx, const shape& output_shape, std::vector<argument> args) const
+    {
+        auto result   = args.back();
+        auto cols     = output_shape.lens().back();
+        auto rows     = (cols == 0) ? 0 : output_shape.elements() / cols;
+        auto* output  = reinterpret_cast<float*>(result.data());
+        const auto* x = reinterpret_cast<const float*>(args[0].data());
+        const auto* y = residual ? reinterpret_cast<const float*>(args[1].data()) : nullptr;
+        const float* scale       = nullptr;
+        const float* shift       = nullptr;
+        std::size_t scale_stride = 0;
+        std::size_t shift_stride = 0;
+        if(affine)
+        {
+            const auto& scale_arg = args[args.size() - 3];
+            const auto& shift_arg = args[args.size() - 2];
+            scale        = reinterpret_cast<const float*>(scale_arg.data());
+            shift        = reinterpret_cast<const float*>(shift_arg.data());
+            scale_stride = scale_arg.get_shape().strides().back();
+            shift_stride = shift_arg.get_shape().strides().back();
+        }
+        float eps  = epsilon;
+        auto grain = std::max<std::size_t>(1, 4096 / std::max<std::size_t>(cols, 1));
+        ctx.bulk_execute(rows, grain, [&](auto start, auto end) {
+            for(auto row = start; row < end; row++)
+            {
+                auto* out      = output + row * cols;
+                const auto* xr = x + row * cols;
+                float sum      = 0;
+                // Write the input, including the residual, to the output so it stays in cache
+                for(std::size_t c = 0; c < cols; c++)
+                {
+                    out[c] = residual ? xr[c] + y[row * cols + c] : xr[c];
+                    sum += out[c];
+                }
+                float mean = sum / cols;
+                float sq   = 0;
+                for(std::size_t c = 0; c < cols; c++)
+                    sq += (out[c] - mean) * (out[c] - mean);
+                float rstd = 1.0f / std::sqrt(sq / cols + eps);
+                for(std::size_t c = 0; c < cols; c++)
+                {
+                    auto v = (out[c] - mean) * rstd;
+                    if(affine)
+                        v = v * scale[c * scale_stride] + shift[c * shift_stride];
+                    out[c] = v;
+                }
+            }
+        });
+        return result;
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
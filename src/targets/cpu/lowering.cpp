@@ -29,6 +29,7 @@
 #include <migraphx/make_op.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/tune_axis.hpp>
+#include <migraphx/match/attention.hpp>
 #include <migraphx/match/layernorm.hpp>
 #include <migraphx/match/gelu_erf.hpp>
 #include <migraphx/match/gelu_tanh.hpp>
@@ -325,6 +326,33 @@ struct cpu_apply
         });
     }
 
+    // Uses dnnl when the axis is the innermost, and the online kernel when it is strided
+    void extend_softmax(const std::string& op_name)
+    {
+        apply_map.emplace(op_name, [=](instruction_ref ins) {
+            auto v        = ins->get_operator().to_value();
+            auto axis     = v.at("axis").to<std::size_t>();
+            const auto& s = ins->inputs().front()->get_shape();
+            if(s.standard() and axis + 1 < s.lens().size())
+                return replace(ins, make_op("cpu::" + op_name, v));
+            return replace(ins, make_op("dnnl::" + op_name, v));
+        });
+    }
+
+    // The kernel only handles standard float inputs, others use the reference implementation
+    void extend_dequant_dot()
+    {
+        apply_map.emplace("dequant_dot", [=](instruction_ref ins) {
+            auto inputs = ins->inputs();
+            if(ins->get_shape().type() != shape::float_type or
+               not std::all_of(inputs.begin(), inputs.end(), [](auto input) {
+                   return input->get_shape().standard();
+               }))
+                return ins;
+            return replace(ins, make_op("cpu::dequant_dot", ins->get_operator().to_value()));
+        });
+    }
+
     void extend_dnnl_algos(const std::string& dnnl_name,
                            const std::vector<std::pair<std::string, std::string>>& algos)
     {
@@ -358,6 +386,122 @@ struct cpu_apply
         });
     }
 
+    auto fuse_layernorm()
+    {
+        auto layernorm =
+            match::layernorm([](auto x) { return match::name(x); }, match::is_constant());
+        return match::make_match_finder(layernorm, [=](auto&, const auto& r) {
+            this->apply_layernorm(
+                r.result, r.instructions["x"], r.instructions["mean"], r.instructions["epsilon"]);
+        });
+    }
+
+    // The input of ins that is not x, when ins has x as an input and is its only output
+    static instruction_ref other_input(instruction_ref ins, instruction_ref x)
+    {
+        const auto& inputs = ins->inputs();
+        return inputs.front() == x ? inputs.back() : inputs.front();
+    }
+
+    void apply_layernorm(instruction_ref ins,
+                         instruction_ref x,
+                         instruction_ref mean,
+                         instruction_ref epsilon_ins) const
+    {
+        auto epsilon = read_scalar<float>(epsilon_ins);
+        auto axes    = mean->get_operator().to_value()["axes"].to_vector<std::int64_t>();
+        auto rank    = static_cast<std::int64_t>(x->get_shape().lens().size());
+        // The rows are normalized in place in memory, so a packed but transposed or otherwise
+        // non-standard input is left to the unfused operators
+        if(epsilon.empty() or axes != std::vector<std::int64_t>{rank - 1} or
+           not x->get_shape().standard())
+            return;
+        std::vector<instruction_ref> inputs{x};
+        // The add is only used by the sub and reduce_mean of the layernorm, and since the inputs
+        // have the same shape as the add, which is standard, they are standard too
+        bool residual = x->name() == "add" and x->outputs().size() == 2 and
+                        std::all_of(x->inputs().begin(), x->inputs().end(), [&](auto input) {
+                            return input->get_shape() == x->get_shape();
+                        });
+        if(residual)
+            inputs = x->inputs();
+        auto last   = ins;
+        bool affine = false;
+        auto is_only_output = [](instruction_ref i, const std::string& name) {
+            return i->outputs().size() == 1 and i->outputs().front()->name() == name;
+        };
+        if(is_only_output(ins, "mul") and is_only_output(ins->outputs().front(), "add"))
+        {
+            auto mul   = ins->outputs().front();
+            auto add   = mul->outputs().front();
+            auto scale = other_input(mul, ins);
+            auto shift = other_input(add, mul);
+            auto is_row_broadcast = [&](instruction_ref i) {
+                const auto& strides = i->get_shape().strides();
+                return i != ins and i != mul and i->get_shape().lens() == x->get_shape().lens() and
+                       std::all_of(strides.begin(), strides.end() - 1, [](auto stride) {
+                           return stride == 0;
+                       });
+            };
+            if(is_row_broadcast(scale) and is_row_broadcast(shift) and
+               (residual or x->get_shape().standard()))
+            {
+                affine = true;
+                last   = add;
+                inputs.push_back(scale);
+                inputs.push_back(shift);
+            }
+        }
+        if(not residual and not affine)
+        {
+            replace(ins, make_op("dnnl::layernorm", {{"epsilon", epsilon.front()}}), {x});
+            return;
+        }
+        replace(last,
+                make_op("cpu::layernorm",
+                        {{"epsilon", epsilon.front()}, {"residual", residual}, {"affine", affine}}),
+                inputs);
+    }
+
+    auto fuse_attention()
+    {
+        return match::make_match_finder(match::attention(), [=](auto&, const auto& r) {
+            this->apply_attention(r.result, r.instructions["softmax"], r.instructions["v"]);
+        });
+    }
+
+    void apply_attention(instruction_ref ins, instruction_ref softmax, instruction_ref v) const
+    {
+        auto chain = match::attention_scores_chain(softmax->inputs().front());
+        if(chain.empty())
+            return;
+        auto scores = chain.back();
+        auto rank   = scores->get_shape().lens().size();
+        if(scores->get_shape().type() != shape::float_type or
+           softmax->get_operator().to_value()["axis"].to<std::size_t>() != rank - 1)
+            return;
+        auto inputs = scores->inputs();
+        inputs.push_back(v);
+        float scale = 1.0f;
+        for(auto it = chain.begin(); it != std::prev(chain.end()); ++it)
+        {
+            auto x     = *it;
+            auto next  = *std::next(it);
+            auto other = x->inputs().front() == next ? x->inputs().back() : x->inputs().front();
+            if(x->name() == "add")
+            {
+                inputs.push_back(other);
+                continue;
+            }
+            auto value = read_scalar<float>(other);
+            if(value.empty())
+                return;
+            scale = (x->name() == "div") ? scale / value.front() : scale * value.front();
+        }
+        inputs.push_back(this->insert_allocation(ins, ins->get_shape()));
+        modl->replace_instruction(ins, make_op("cpu::attention", {{"scale", scale}}), inputs);
+    }
+
     void init()
     {
         create_output_names();
@@ -396,11 +540,13 @@ struct cpu_apply
         extend_op("deconvolution", "dnnl::deconvolution");
         extend_op("dot", "dnnl::dot");
 #endif
+        extend_dequant_dot();
         extend_op("erf", "cpu::erf");
         extend_op("gather", "cpu::gather");
-        extend_op("logsoftmax", "dnnl::logsoftmax");
+        extend_op("gathernd", "cpu::gathernd");
+        extend_softmax("logsoftmax");
         extend_op("lrn", "dnnl::lrn");
-        extend_op("softmax", "dnnl::softmax");
+        extend_softmax("softmax");
         extend_op("sub", "cpu::sub");
 
         extend_op("im2col", "cpu::im2col", false);
@@ -420,7 +566,8 @@ struct cpu_apply
                             fuse_match(match::gelu_tanh(),
                                        make_op("dnnl::eltwise", {{"algo", "eltwise_gelu_tanh"}}),
                                        {"x"}),
-                            fuse_match(match::layernorm(), make_op("dnnl::layernorm"), {"x"}));
+                            fuse_layernorm(),
+                            fuse_attention());
         // Apply these operators first so the inputs can be const folded
         for(auto it : iterator_for(*modl))
         {
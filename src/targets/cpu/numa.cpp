@@ -0,0 +1,161 @@
+#include <migraphx/cpu/numa.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <fstream>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CPU_NUMA_POLICY);
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CPU_NUMA_NODE);
+
+std::string to_string(numa_policy policy)
+{
+    switch(policy)
+    {
+    case numa_policy::none: return "none";
+    case numa_policy::spread: return "spread";
+    case numa_policy::local: return "local";
+    }
+    MIGRAPHX_THROW("Unknown numa policy");
+}
+
+numa_policy to_numa_policy(const std::string& name)
+{
+    for(auto policy : {numa_policy::none, numa_policy::spread, numa_policy::local})
+    {
+        if(to_string(policy) == name)
+            return policy;
+    }
+    MIGRAPHX_THROW("Unknown numa policy: " + name);
+}
+
+numa_policy get_numa_policy()
+{
+    // Not cached, so the policy can be changed between compiles
+    return to_numa_policy(string_value_of(MIGRAPHX_CPU_NUMA_POLICY::value(), "none"));
+}
+
+static std::vector<std::size_t> allowed_cpus()
+{
+    std::vector<std::size_t> result;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0, sizeof(set), &set) != 0)
+        return result;
+    for(std::size_t i = 0; i < CPU_SETSIZE; i++)
+    {
+        if(CPU_ISSET(i, &set))
+            result.push_back(i);
+    }
+    return result;
+}
+
+std::vector<std::size_t> parse_cpu_list(const std::string& s)
+{
+    std::vector<std::size_t> result;
+    for(const auto& x : split_string(s, ','))
+    {
+        // A node with only memory has an empty list
+        auto r = trim(x);
+        if(r.empty())
+            continue;
+        auto bounds = split_string(r, '-');
+        auto first  = std::stoul(bounds.front());
+        auto last   = std::stoul(bounds.back());
+        for(auto i = first; i <= last; i++)
+            result.push_back(i);
+    }
+    return result;
+}
+
+std::vector<std::vector<std::size_t>> get_numa_nodes()
+{
+    auto allowed = allowed_cpus();
+    std::vector<std::vector<std::size_t>> nodes;
+    for(std::size_t node = 0;; node++)
+    {
+        std::ifstream is("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if(not is)
+            break;
+        std::string line;
+        std::getline(is, line);
+        std::vector<std::size_t> cpus;
+        for(auto i : parse_cpu_list(line))
+        {
+            if(std::find(allowed.begin(), allowed.end(), i) != allowed.end())
+                cpus.push_back(i);
+        }
+        nodes.push_back(cpus);
+    }
+    // Without sysfs the whole machine is treated as one node
+    if(std::all_of(nodes.begin(), nodes.end(), [](const auto& cpus) { return cpus.empty(); }))
+        return {allowed};
+    return nodes;
+}
+
+std::vector<std::size_t> get_numa_cpus(numa_policy policy,
+                                       const std::vector<std::vector<std::size_t>>& nodes,
+                                       std::size_t node)
+{
+    if(policy == numa_policy::none)
+        return {};
+    if(policy == numa_policy::local)
+    {
+        if(node >= nodes.size() or nodes[node].empty())
+            MIGRAPHX_THROW("No cpus available on numa node " + std::to_string(node));
+        return nodes[node];
+    }
+    // Take a cpu from each node in turn
+    std::vector<std::size_t> result;
+    for(std::size_t i = 0;; i++)
+    {
+        bool found = false;
+        for(const auto& cpus : nodes)
+        {
+            if(i >= cpus.size())
+                continue;
+            result.push_back(cpus[i]);
+            found = true;
+        }
+        if(not found)
+            break;
+    }
+    return result;
+}
+
+std::vector<std::size_t> get_numa_cpus(numa_policy policy)
+{
+    if(policy == numa_policy::none)
+        return {};
+    return get_numa_cpus(policy, get_numa_nodes(), value_of(MIGRAPHX_CPU_NUMA_NODE::value(), 0));
+}
+
+void pin_thread(std::size_t cpu)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    // A pid of 0 is the calling thread
+    sched_setaffinity(0, sizeof(set), &set);
+}
+
+scoped_pin::scoped_pin(std::size_t cpu)
+{
+    CPU_ZERO(&affinity);
+    restore = sched_getaffinity(0, sizeof(affinity), &affinity) == 0;
+    pin_thread(cpu);
+}
+
+scoped_pin::~scoped_pin()
+{
+    if(restore)
+        sched_setaffinity(0, sizeof(affinity), &affinity);
+}
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -1,6 +1,11 @@
 #include <migraphx/config.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/cpu/context.hpp>
 #include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/op/logsoftmax.hpp>
 #include <migraphx/op/softmax.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/softmax.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -15,6 +20,52 @@ struct dnnl_softmax : dnnl_extend_op<dnnl_softmax, dnnl::softmax_forward, op::so
     }
 };
 
+/**
+ * Softmax and logsoftmax over an axis that is not the innermost, which dnnl handles by striding
+ * through the axis one element at a time. The online kernel reads the axis once for a tile of
+ * the inner dimension.
+ */
+template <class Op>
+struct cpu_softmax : auto_register_op<cpu_softmax<Op>>
+{
+    Op op;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::reflect(self.op, f);
+    }
+    std::string name() const { return "cpu::" + op.name(); }
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        // Compensate for allocation
+        inputs.pop_back();
+        check_shapes{inputs, *this}.has(1).standard();
+        return op.normalize_compute_shape(inputs);
+    }
+
+    argument
+    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
+    {
+        online_softmax<float> f{output_shape, std::size_t(op.axis), op.name() == "logsoftmax"};
+        visit_all(args.back(), args.front())([&](auto output, auto input) {
+            ctx.bulk_execute(f.tasks(), 1, [&](auto start, auto end) {
+                for(auto i = start; i < end; i++)
+                    f(input.data(), output.data(), i);
+            });
+        });
+        return args.back();
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+template struct cpu_softmax<op::softmax>;
+template struct cpu_softmax<op::logsoftmax>;
+
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
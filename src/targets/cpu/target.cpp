@@ -19,17 +19,23 @@
 #include <migraphx/rewrite_rnn.hpp>
 #include <migraphx/schedule.hpp>
 #include <migraphx/memory_coloring.hpp>
+#include <migraphx/reorder_memory.hpp>
 #include <migraphx/simplify_algebra.hpp>
 #include <migraphx/simplify_qdq.hpp>
 #include <migraphx/simplify_reshapes.hpp>
+#include <migraphx/sink_transpose.hpp>
+#include <migraphx/tile_spatial.hpp>
 #include <migraphx/preallocate_param.hpp>
+#include <migraphx/cpu/concat_cpu_opt.hpp>
 #include <migraphx/cpu/fuse_ops.hpp>
+#include <migraphx/cpu/tune_ops.hpp>
 #include <migraphx/cpu/write_literals.hpp>
 #include <migraphx/cpu/allocation_model.hpp>
 #include <migraphx/cpu/target.hpp>
 #include <migraphx/cpu/context.hpp>
 #include <migraphx/cpu/lowering.hpp>
 #include <migraphx/pass.hpp>
+#include <migraphx/pass_config.hpp>
 #include <migraphx/generate.hpp>
 #include <migraphx/normalize_ops.hpp>
 
@@ -37,6 +43,9 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CPU_TUNE)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CPU_TUNING_DB)
+
 std::string target::name() const { return "cpu"; }
 
 // cppcheck-suppress constParameter
@@ -60,6 +69,8 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             dead_code_elimination{},
             eliminate_common_subexpression{},
             dead_code_elimination{},
+            sink_transpose{},
+            dead_code_elimination{},
             simplify_algebra{},
             simplify_reshapes{},
             simplify_algebra{},
@@ -67,6 +78,8 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             simplify_reshapes{},
             propagate_constant{},
             dead_code_elimination{},
+            tile_spatial{},
+            dead_code_elimination{},
             lowering{},
             eliminate_contiguous{"dnnl::reorder"},
             dead_code_elimination{},
@@ -74,8 +87,14 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             dead_code_elimination{},
             fuse_ops{&ctx},
             dead_code_elimination{},
-            write_literals{},
+            eliminate_concat{concat_cpu_optimization{}},
+            dead_code_elimination{},
+            tune_ops{&ctx,
+                     enabled(MIGRAPHX_CPU_TUNE{}),
+                     string_value_of(MIGRAPHX_CPU_TUNING_DB{})},
+            write_literals{&ctx},
             dead_code_elimination{},
+            reorder_memory{"cpu::allocate", not enabled(MIGRAPHX_DISABLE_REORDER_MEMORY{})},
             memory_coloring{"cpu::allocate"},
             dead_code_elimination{},
             preallocate_param{"scratch", cpu_allocation_model{}},
@@ -0,0 +1,144 @@
+#include <migraphx/cpu/tune_ops.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/serialize.hpp>
+#include <migraphx/time.hpp>
+#include <limits>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+// Number of timed runs of each algorithm, after a run to warm up
+static const std::size_t tuning_iterations = 5;
+
+static const std::unordered_map<std::string, std::vector<std::string>>& tuning_algos()
+{
+    static const std::unordered_map<std::string, std::vector<std::string>> m = {
+        {"dnnl::convolution", {"convolution_auto", "convolution_direct", "convolution_winograd"}},
+        {"dnnl::deconvolution", {"deconvolution_direct", "deconvolution_winograd"}},
+    };
+    return m;
+}
+
+std::string tuning_db_key()
+{
+    const auto* v = dnnl::version();
+    return "dnnl-" + std::to_string(v->major) + "." + std::to_string(v->minor) + "." +
+           std::to_string(v->patch) + "-isa" +
+           std::to_string(static_cast<int>(dnnl::get_effective_cpu_isa()));
+}
+
+std::string problem_key(instruction_ref ins)
+{
+    value attributes = value::object{};
+    for(const auto& x : ins->get_operator().to_value())
+    {
+        if(x.get_key() != "algo")
+            attributes[x.get_key()] = x.without_key();
+    }
+    value problem = {{"name", ins->name()},
+                     {"attributes", attributes},
+                     {"inputs", migraphx::to_value(to_shapes(ins->inputs()))}};
+    return to_json_string(problem);
+}
+
+static operation with_algo(instruction_ref ins, const std::string& algo)
+{
+    auto v    = ins->get_operator().to_value();
+    v["algo"] = algo;
+    return make_op(ins->name(), v);
+}
+
+// The fastest time of the operator in microseconds
+static double
+benchmark(context& ctx, operation op, const shape& output, const std::vector<shape>& inputs)
+{
+    migraphx::context gctx = ctx;
+    op.finalize(gctx, output, inputs);
+    std::vector<argument> args(inputs.size());
+    std::transform(inputs.begin(), inputs.end(), args.begin(), [](const shape& s) {
+        return generate_argument(s);
+    });
+    op.compute(gctx, output, args);
+    double result = std::numeric_limits<double>::max();
+    for(std::size_t i = 0; i < tuning_iterations; i++)
+    {
+        auto t = time<std::chrono::duration<double, std::micro>>(
+            [&] { op.compute(gctx, output, args); });
+        result = std::min(result, t);
+    }
+    return result;
+}
+
+static std::string tune_algo(context& ctx, instruction_ref ins)
+{
+    auto inputs    = to_shapes(ins->inputs());
+    auto result    = ins->get_operator().to_value()["algo"].to<std::string>();
+    auto best_time = std::numeric_limits<double>::max();
+    for(const auto& algo : tuning_algos().at(ins->name()))
+    {
+        auto op = with_algo(ins, algo);
+        // Skip the algorithms that dnnl doesn't support for this problem
+        auto output = try_compute_shape(op, inputs);
+        if(output.empty() or output.front() != ins->get_shape())
+            continue;
+        auto t = benchmark(ctx, op, output.front(), inputs);
+        if(t < best_time)
+        {
+            best_time = t;
+            result    = algo;
+        }
+    }
+    return result;
+}
+
+void tune_ops::apply(module& m) const
+{
+    if(not tune and db_file.empty())
+        return;
+    value db = value::object{};
+    if(not db_file.empty() and fs::exists(db_file))
+        db = from_json_string(read_string(db_file));
+    auto& problems = db[tuning_db_key()];
+    if(problems.is_null())
+        problems = value::object{};
+    bool changed = false;
+    for(auto ins : iterator_for(m))
+    {
+        if(not contains(tuning_algos(), ins->name()))
+            continue;
+        auto key = problem_key(ins);
+        if(not problems.contains(key))
+        {
+            if(not tune)
+                continue;
+            problems[key] = tune_algo(*ctx, ins);
+            changed       = true;
+        }
+        auto op     = with_algo(ins, problems.at(key).to<std::string>());
+        auto output = try_compute_shape(op, to_shapes(ins->inputs()));
+        if(output.empty() or output.front() != ins->get_shape())
+            continue;
+        m.replace_instruction(ins, op, ins->inputs());
+    }
+    if(changed and not db_file.empty())
+    {
+        auto s = to_pretty_json_string(db);
+        write_buffer(db_file, s.data(), s.size());
+    }
+}
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
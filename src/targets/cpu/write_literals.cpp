@@ -1,7 +1,9 @@
 #include <migraphx/cpu/write_literals.hpp>
+#include <migraphx/cpu/context.hpp>
 #include <migraphx/module.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/iterator_for.hpp>
+#include <cstring>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -30,13 +32,27 @@ struct cpu_literal
     }
 };
 
+// Copies the literal into memory on the node of the worker threads
+static argument replicate(context& ctx, const argument& arg)
+{
+    argument result{arg.get_shape()};
+    ctx.first_touch(result);
+    std::memcpy(result.data(), arg.data(), arg.get_shape().bytes());
+    return result;
+}
+
 void write_literals::apply(module& m) const
 {
     for(auto ins : iterator_for(m))
     {
         if(ins->name() != "@literal")
             continue;
-        m.replace_instruction(ins, cpu_literal{ins->get_literal().get_argument()});
+        // The target gets its own copy, so a buffer shared with other literals is never written
+        const auto& l = ins->get_literal();
+        if(ctx != nullptr and ctx->policy == numa_policy::local)
+            m.replace_instruction(ins, cpu_literal{replicate(*ctx, l.share_argument())});
+        else
+            m.replace_instruction(ins, cpu_literal{l.get_argument()});
     }
 }
 
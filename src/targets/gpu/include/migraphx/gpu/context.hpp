@@ -154,6 +154,18 @@ struct hip_device
 
     std::size_t get_cu_count() const { return device_props.multiProcessorCount; }
 
+    // Each compute unit issues a fused multiply-add on 64 lanes every cycle
+    double get_peak_flops() const
+    {
+        return 2.0 * 64 * get_cu_count() * device_props.clockRate * 1e3;
+    }
+
+    // The memory transfers on both edges of its clock
+    double get_peak_bandwidth() const
+    {
+        return 2.0 * device_props.memoryClockRate * 1e3 * device_props.memoryBusWidth / 8;
+    }
+
     std::size_t get_max_workitems_per_cu() const
     {
         return device_props.maxThreadsPerMultiProcessor;
@@ -2,6 +2,7 @@
 #define MIGRAPHX_GUARD_RTGLIB_GPU_SCHEDULE_MODEL_HPP
 
 #include <migraphx/config.hpp>
+#include <migraphx/cost_model.hpp>
 #include <migraphx/instruction_ref.hpp>
 #include <vector>
 
@@ -23,6 +24,12 @@ struct schedule_model
     std::size_t weight(const operation& op) const;
 };
 
+struct context;
+
+// Estimates the costs from the peaks of the device, or reads them from the perf report set by
+// MIGRAPHX_SCHEDULE_PERF_REPORT
+cost_model make_cost_model(const context& ctx);
+
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
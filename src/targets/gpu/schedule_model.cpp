@@ -4,11 +4,14 @@
 #include <migraphx/program.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/operation.hpp>
+#include <migraphx/env.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_SCHEDULE_PERF_REPORT)
+
 struct record_event
 {
     std::size_t event = 0;
@@ -128,6 +131,17 @@ std::size_t schedule_model::weight(const operation& op) const
     return weight_map().at(op.name());
 }
 
+cost_model make_cost_model(const context& ctx)
+{
+    cost_model result;
+    result.flops       = ctx.get_current_device().get_peak_flops();
+    result.bandwidth   = ctx.get_current_device().get_peak_bandwidth();
+    std::string report = string_value_of(MIGRAPHX_SCHEDULE_PERF_REPORT{});
+    if(not report.empty())
+        result.times = read_perf_report(report);
+    return result;
+}
+
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -120,7 +120,7 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
         compile_ops{&ctx},
         dead_code_elimination{},
         write_literals{&ctx},
-        schedule{gpu::schedule_model{ctx.get_current_device().nstreams()}, not enabled(MIGRAPHX_DISABLE_SCHEDULE_PASS{})},
+        schedule{gpu::schedule_model{ctx.get_current_device().nstreams()}, not enabled(MIGRAPHX_DISABLE_SCHEDULE_PASS{}), gpu::make_cost_model(ctx)},
         memory_coloring{"hip::allocate"},
         sync_device{},
         preallocate_param{"scratch", gpu_allocation_model{}},
@@ -21,6 +21,7 @@
 #include <migraphx/op/argmin.hpp>
 #include <migraphx/op/rnn_var_sl_last_output.hpp>
 #include <migraphx/shape_for_each.hpp>
+#include <migraphx/softmax.hpp>
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/par_dfor.hpp>
 #include <migraphx/clamp.hpp>
@@ -95,9 +96,10 @@ struct ref_batch_norm_inference
         {
             visit_all(output, input, mini_batch_mean, mini_batch_variance, arg_gamma, arg_bias)(
                 [&](auto result, auto buffer, auto mean, auto variance, auto gamma, auto bias) {
+                    auto channel_stride = output_shape.strides()[1];
+                    auto channels       = output_shape.lens()[1];
                     par_for(output_shape.elements(), [&](auto i) {
-                        auto idx = output_shape.multi(i);
-                        auto c   = idx[1];
+                        auto c = (i / channel_stride) % channels;
                         assert((variance[c] + epsilon) > 0);
                         result[i] =
                             gamma[c] * (buffer[i] - mean[c]) / std::sqrt(variance[c] + epsilon) +
@@ -110,10 +112,10 @@ struct ref_batch_norm_inference
         {
             visit_all(output, input, mini_batch_mean, mini_batch_variance, arg_gamma, arg_bias)(
                 [&](auto result, auto buffer, auto mean, auto variance, auto gamma, auto bias) {
+                    auto batch_stride = output_shape.strides()[0];
                     par_for(output_shape.elements(), [&](auto i) {
-                        auto idx   = output_shape.multi(i);
-                        idx[0]     = 0;
-                        auto index = output_shape.index(idx);
+                        // Index of the element with the batch index set to zero
+                        auto index = i % batch_stride;
 
                         assert((variance[index] + epsilon) > 0);
                         result[i] = gamma[index] * (buffer[i] - mean[index]) /
@@ -550,6 +552,17 @@ struct ref_softmax : auto_register_op<ref_softmax<Op>>
         batch_lens[tuned_axis] = 1;
         shape batch_shape{shape::int32_type, batch_lens};
 
+        if(args[0].get_shape().standard() and output_shape.standard())
+        {
+            visit_all(result, args[0])([&](auto output, auto input) {
+                using value_type = accumulator_type<typename decltype(input)::value_type>;
+                online_softmax<value_type> f{
+                    output_shape, std::size_t(tuned_axis), op.name() == "logsoftmax"};
+                par_for(f.tasks(), [&](auto i) { f(input.data(), output.data(), i); });
+            });
+            return result;
+        }
+
         visit_all(result, args[0])([&](auto output, auto input) {
             using value_type = accumulator_type<typename decltype(input)::value_type>;
             std::vector<value_type> batch_max(batch_shape.elements(),
@@ -0,0 +1,246 @@
+#include <migraphx/tile_spatial.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/op/convolution.hpp>
+#include <migraphx/op/pooling.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/ranges.hpp>
+#include <unordered_set>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// The height of NCHW
+static const std::size_t tile_axis = 2;
+
+// The window of a convolution or a pooling along the height
+struct window
+{
+    std::size_t size       = 1;
+    std::size_t stride     = 1;
+    std::size_t pad_top    = 0;
+    std::size_t pad_bottom = 0;
+};
+
+// Rows of an input or an output, and the padding added to the rows of an input
+struct row_range
+{
+    std::size_t start      = 0;
+    std::size_t end        = 0;
+    std::size_t pad_top    = 0;
+    std::size_t pad_bottom = 0;
+};
+
+static window make_window(std::size_t size,
+                          std::size_t stride,
+                          const std::vector<std::size_t>& padding,
+                          std::size_t kdims)
+{
+    window w;
+    w.size       = size;
+    w.stride     = stride;
+    w.pad_top    = padding.front();
+    w.pad_bottom = padding.size() == 2 * kdims ? padding.at(kdims) : padding.front();
+    return w;
+}
+
+// Returns the window of the operator, or nothing when the operator is not a convolution or a
+// pooling that can be computed on a tile
+static optional<window> get_window(instruction_ref ins)
+{
+    if(ins->get_shape().lens().size() <= tile_axis)
+        return nullopt;
+    if(ins->name() == "convolution")
+    {
+        const auto& op = any_cast<const op::convolution&>(ins->get_operator());
+        if(op.padding_mode != op::padding_mode_t::default_)
+            return nullopt;
+        auto k = ins->inputs().at(1)->get_shape().lens().at(tile_axis);
+        return make_window(
+            (k - 1) * op.dilation.front() + 1, op.stride.front(), op.padding, op.kdims());
+    }
+    if(ins->name() == "pooling")
+    {
+        const auto& op = any_cast<const op::pooling&>(ins->get_operator());
+        // A tile has no partial window at the end for the ceil mode to round up
+        if(op.ceil_mode)
+            return nullopt;
+        return make_window(op.lengths.front(), op.stride.front(), op.padding, op.kdims());
+    }
+    return nullopt;
+}
+
+static bool is_pointwise(instruction_ref ins)
+{
+    return ins->get_operator().attributes().contains("pointwise") and
+           ins->get_shape().lens().size() > tile_axis;
+}
+
+static bool is_spatial(instruction_ref ins) { return get_window(ins) or is_pointwise(ins); }
+
+// Each instruction of the chain is only used by the next one, as the input of the window for a
+// convolution or a pooling
+static bool can_extend(const module& m, instruction_ref ins)
+{
+    if(ins->outputs().size() != 1 or ins == std::prev(m.end()))
+        return false;
+    auto next = ins->outputs().front();
+    if(not is_spatial(next) or next->get_shape().lens().size() != ins->get_shape().lens().size())
+        return false;
+    if(get_window(next))
+        return next->inputs().front() == ins and
+               std::count(next->inputs().begin(), next->inputs().end(), ins) == 1;
+    return true;
+}
+
+static std::vector<std::vector<instruction_ref>> find_chains(const module& m)
+{
+    std::vector<std::vector<instruction_ref>> result;
+    std::unordered_set<instruction_ref> visited;
+    for(auto ins : iterator_for(m))
+    {
+        if(contains(visited, ins) or not is_spatial(ins))
+            continue;
+        std::vector<instruction_ref> chain = {ins};
+        while(can_extend(m, chain.back()))
+            chain.push_back(chain.back()->outputs().front());
+        visited.insert(chain.begin(), chain.end());
+        // With a single window the pointwise operators are fused into it, so there is no
+        // intermediate to keep in cache
+        auto windows = std::count_if(chain.begin(), chain.end(), [](auto x) {
+            return static_cast<bool>(get_window(x));
+        });
+        if(windows > 1)
+            result.push_back(chain);
+    }
+    return result;
+}
+
+// Computes the rows of the input of each instruction needed for the rows of the output of the
+// chain, or nothing when a tile would need padding that the operator does not have
+static optional<std::vector<row_range>> plan_tile(const std::vector<instruction_ref>& chain,
+                                                  std::size_t start,
+                                                  std::size_t end)
+{
+    std::vector<row_range> result(chain.size());
+    for(std::size_t i = chain.size(); i > 0; i--)
+    {
+        auto ins = chain[i - 1];
+        auto w   = get_window(ins);
+        row_range r{start, end};
+        if(w)
+        {
+            auto height = static_cast<std::ptrdiff_t>(
+                ins->inputs().front()->get_shape().lens().at(tile_axis));
+            auto lo = static_cast<std::ptrdiff_t>(start * w->stride) -
+                      static_cast<std::ptrdiff_t>(w->pad_top);
+            auto hi = static_cast<std::ptrdiff_t>((end - 1) * w->stride + w->size) -
+                      static_cast<std::ptrdiff_t>(w->pad_top);
+            r.start      = std::max<std::ptrdiff_t>(lo, 0);
+            r.end        = std::min<std::ptrdiff_t>(hi, height);
+            r.pad_top    = r.start - lo;
+            r.pad_bottom = hi - r.end;
+            if(r.pad_bottom > w->pad_bottom)
+                return nullopt;
+        }
+        result[i - 1] = r;
+        start         = r.start;
+        end           = r.end;
+    }
+    return result;
+}
+
+// Returns the rows of an input, which are copied when they are not a view that the operators
+// can read directly
+static instruction_ref
+slice_rows(module& m, instruction_ref pos, instruction_ref input, const row_range& r)
+{
+    if(r.start == 0 and r.end == input->get_shape().lens().at(tile_axis))
+        return input;
+    auto result = m.insert_instruction(
+        pos,
+        make_op("slice",
+                {{"axes", {tile_axis}}, {"starts", {r.start}}, {"ends", {r.end}}}),
+        input);
+    if(result->get_shape().broadcasted())
+        return result;
+    return m.insert_instruction(pos, make_op("contiguous"), result);
+}
+
+// The operator of a tile, with the padding of the tile along the height
+static operation tile_operator(instruction_ref ins, const row_range& r)
+{
+    auto v       = ins->get_operator().to_value();
+    auto padding = v.at("padding").to_vector<std::size_t>();
+    auto kdims   = ins->get_shape().lens().size() - tile_axis;
+    if(padding.size() == kdims)
+    {
+        auto pads = padding;
+        padding.insert(padding.end(), pads.begin(), pads.end());
+    }
+    padding.front()   = r.pad_top;
+    padding.at(kdims) = r.pad_bottom;
+    v["padding"]      = padding;
+    return make_op(ins->name(), v);
+}
+
+static instruction_ref insert_tile(module& m,
+                                   const std::vector<instruction_ref>& chain,
+                                   const std::vector<row_range>& plan)
+{
+    auto pos = chain.back();
+    instruction_ref result;
+    for(std::size_t i = 0; i < chain.size(); i++)
+    {
+        auto ins    = chain[i];
+        auto inputs = ins->inputs();
+        if(get_window(ins))
+        {
+            inputs.front() = i == 0 ? slice_rows(m, pos, inputs.front(), plan[i]) : result;
+            result         = m.insert_instruction(pos, tile_operator(ins, plan[i]), inputs);
+            continue;
+        }
+        for(auto& input : inputs)
+            input = (i > 0 and input == chain[i - 1]) ? result
+                                                      : slice_rows(m, pos, input, plan[i]);
+        result = m.insert_instruction(pos, ins->get_operator(), inputs);
+    }
+    return result;
+}
+
+void tile_spatial::apply(module& m) const
+{
+    for(const auto& chain : find_chains(m))
+    {
+        std::size_t bytes = 0;
+        for(auto ins : range(chain.begin(), std::prev(chain.end())))
+            bytes = std::max(bytes, ins->get_shape().bytes());
+        if(bytes <= tile_bytes)
+            continue;
+        auto height = chain.back()->get_shape().lens().at(tile_axis);
+        auto ntiles = std::min((bytes + tile_bytes - 1) / tile_bytes, height / min_rows);
+        if(ntiles < 2)
+            continue;
+        auto rows = (height + ntiles - 1) / ntiles;
+        std::vector<std::vector<row_range>> plans;
+        for(std::size_t start = 0; start < height; start += rows)
+        {
+            auto plan = plan_tile(chain, start, std::min(start + rows, height));
+            if(not plan)
+                break;
+            plans.push_back(*plan);
+        }
+        if(plans.size() != (height + rows - 1) / rows)
+            continue;
+        std::vector<instruction_ref> tiles;
+        std::transform(plans.begin(), plans.end(), std::back_inserter(tiles), [&](auto& plan) {
+            return insert_tile(m, chain, plan);
+        });
+        m.replace_instruction(chain.back(), make_op("concat", {{"axis", tile_axis}}), tiles);
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
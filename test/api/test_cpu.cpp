@@ -175,4 +175,72 @@ TEST_CASE(set_loop_default_iter_num)
     EXPECT(out_shapes[1].lengths() == out_lens1);
 }
 
+TEST_CASE(load_and_run_buckets)
+{
+    auto buckets = migraphx::parse_onnx_buckets("variable_batch_test.onnx", {1, 4});
+    buckets.compile(migraphx::target("ref"));
+    EXPECT(buckets.size() == 2);
+    EXPECT(buckets.select(3) == 4);
+    migraphx::program_parameters pp;
+    auto s = migraphx::shape(migraphx_shape_float_type, {3, 3, 16, 16});
+    pp.add("0", migraphx::argument::generate(s));
+    auto outputs                  = buckets.eval(pp);
+    std::vector<std::size_t> lens = {3, 3, 16, 16};
+    EXPECT(outputs.size() == 1);
+    EXPECT(outputs[0].get_shape().lengths() == lens);
+}
+
+TEST_CASE(run_with_bound_output)
+{
+    auto p = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
+    p.compile(migraphx::target("ref"));
+    migraphx::program_parameters pp;
+    auto param_shapes = p.get_parameter_shapes();
+    for(auto&& name : param_shapes.names())
+    {
+        pp.add(name, migraphx::argument::generate(param_shapes[name]));
+    }
+    auto expected = p.eval(pp);
+
+    auto s = p.get_output_shapes().front();
+    std::vector<char> buffer(s.bytes());
+    migraphx::argument output(s, buffer.data());
+    migraphx::run_options options;
+    options.bind_output("main:#output_0", output);
+    auto outputs = p.eval(pp, options);
+    CHECK(outputs.size() == 1);
+    CHECK(outputs.front().data() == buffer.data());
+    CHECK(bool{outputs.front() == expected.front()});
+
+    options.set_copy_outputs(false);
+    EXPECT(test::throws([&] { p.eval(pp, options); }));
+}
+
+TEST_CASE(run_async)
+{
+    auto p = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
+    p.compile(migraphx::target("ref"));
+    migraphx::program_parameters pp;
+    auto param_shapes = p.get_parameter_shapes();
+    for(auto&& name : param_shapes.names())
+    {
+        pp.add(name, migraphx::argument::generate(param_shapes[name]));
+    }
+    auto expected = p.eval(pp);
+
+    migraphx::run_options options;
+    auto status = migraphx_status_unknown_error;
+    auto future = p.eval_async(pp, options, [&](migraphx_status x) { status = x; });
+    future.wait();
+    CHECK(future.ready());
+    CHECK(status == migraphx_status_success);
+    auto outputs = future.get();
+    CHECK(outputs.size() == 1);
+    CHECK(bool{outputs.front() == expected.front()});
+
+    options.bind_output("main:#output_1", outputs.front());
+    auto failed = p.eval_async(pp, options);
+    EXPECT(test::throws([&] { failed.get(); }));
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,58 @@
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <migraphx/migraphx.h>
+#include <migraphx/migraphx.hpp>
+#include "test.hpp"
+
+static bool float_close(const migraphx::argument& x, const migraphx::argument& y)
+{
+    if(not(x.get_shape() == y.get_shape()))
+        return false;
+    auto n        = x.get_shape().bytes() / sizeof(float);
+    const auto* a = reinterpret_cast<const float*>(x.data());
+    const auto* b = reinterpret_cast<const float*>(y.data());
+    return std::equal(a, a + n, b, [](float i, float j) {
+        return std::fabs(i - j) <= 1e-3f * (1.0f + std::fabs(j));
+    });
+}
+
+TEST_CASE(run_with_output_parameter)
+{
+    auto p   = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
+    auto ref = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
+    p.compile(migraphx::target("cpu"));
+    ref.compile(migraphx::target("ref"));
+    // The cpu target writes the output to a parameter
+    auto param_shapes = p.get_parameter_shapes();
+    auto names        = param_shapes.names();
+    CHECK(std::any_of(names.begin(), names.end(), [](const char* name) {
+        return std::string(name) == "main:#output_0";
+    }));
+    migraphx::program_parameters pp;
+    for(auto&& name : ref.get_parameter_shapes().names())
+    {
+        pp.add(name, migraphx::argument::generate(param_shapes[name]));
+    }
+    auto expected = ref.eval(pp);
+
+    auto s = param_shapes["main:#output_0"];
+    std::vector<float> buffer(s.bytes() / sizeof(float));
+    migraphx::argument output(s, buffer.data());
+    migraphx::run_options options;
+    options.bind_output("main:#output_0", output);
+    auto outputs = p.eval(pp, options);
+    CHECK(outputs.size() == 1);
+    CHECK(outputs.front().data() == reinterpret_cast<char*>(buffer.data()));
+    CHECK(float_close(outputs.front(), expected.front()));
+
+    // The output is written in place, so no copy is needed
+    std::fill(buffer.begin(), buffer.end(), 0.0f);
+    options.set_copy_outputs(false);
+    outputs = p.eval(pp, options);
+    CHECK(outputs.front().data() == reinterpret_cast<char*>(buffer.data()));
+    CHECK(float_close(outputs.front(), expected.front()));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,121 @@
+#include <migraphx/compile_profile.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/ref/target.hpp>
+
+#include <test.hpp>
+
+static migraphx::program create_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    auto x   = mm->add_parameter("x", s);
+    auto one = mm->add_literal(migraphx::generate_literal(s, 1));
+    auto add = mm->add_instruction(migraphx::make_op("add"), x, one);
+    mm->add_instruction(migraphx::make_op("mul"), x, x);
+    mm->add_return({add});
+    return p;
+}
+
+TEST_CASE(run_passes_records)
+{
+    auto p = create_program();
+    migraphx::compile_profile profile;
+    migraphx::run_passes(p, {migraphx::dead_code_elimination{}}, {}, &profile);
+    // The pass is only recorded for the main module, since it does not change the program itself
+    EXPECT(profile.records.size() == 1);
+    const auto& r = profile.records.front();
+    EXPECT(r.pass == "dead_code_elimination");
+    EXPECT(r.module == "main");
+    EXPECT(r.instructions_before == 5);
+    EXPECT(r.instructions_after == 4);
+    EXPECT(r.literal_bytes == 6 * sizeof(float));
+    EXPECT(r.scratch_bytes == 0);
+}
+
+struct add_literal_pass
+{
+    std::string name() const { return "add_literal_pass"; }
+    void apply(migraphx::program& p) const { p.get_main_module()->add_literal(1.0f); }
+};
+
+TEST_CASE(run_passes_program_records)
+{
+    auto p = create_program();
+    migraphx::compile_profile profile;
+    migraphx::run_passes(p, {add_literal_pass{}}, {}, &profile);
+    EXPECT(profile.records.size() == 2);
+    const auto& r = profile.records.front();
+    EXPECT(r.module == "main");
+    EXPECT(r.instructions_before == r.instructions_after);
+    const auto& pr = profile.records.back();
+    EXPECT(pr.pass == "add_literal_pass");
+    EXPECT(pr.module.empty());
+    EXPECT(pr.instructions_before == 5);
+    EXPECT(pr.instructions_after == 6);
+    EXPECT(pr.literal_bytes == 7 * sizeof(float));
+    EXPECT(pr.start_ms >= r.start_ms + r.time_ms);
+}
+
+TEST_CASE(compile_records)
+{
+    auto p = create_program();
+    migraphx::compile_profile profile;
+    migraphx::compile_options options;
+    options.profile = &profile;
+    p.compile(migraphx::ref::target{}, options);
+    EXPECT(profile.target == "ref");
+    EXPECT(not profile.records.empty());
+    EXPECT(profile.records.back().pass == "finalize");
+    EXPECT(profile.records.back().module == "main");
+    EXPECT(profile.records.back().instructions_after ==
+           p.get_main_module()->size());
+    EXPECT(profile.total_ms() > 0);
+    EXPECT(std::all_of(profile.records.begin(), profile.records.end(), [](const auto& r) {
+        return r.time_ms >= 0 and r.start_ms >= 0;
+    }));
+}
+
+TEST_CASE(to_value)
+{
+    auto p = create_program();
+    migraphx::compile_profile profile;
+    profile.target = "ref";
+    migraphx::run_passes(
+        p, {migraphx::dead_code_elimination{}, migraphx::dead_code_elimination{}}, {}, &profile);
+    auto v = profile.to_value();
+    EXPECT(v.at("target").to<std::string>() == "ref");
+    EXPECT(v.at("passes").size() == 2);
+    EXPECT(v.at("passes").front().at("module").to<std::string>() == "main");
+    EXPECT(v.at("passes").front().at("instructions_after").to<std::size_t>() == 4);
+    // The time of the pass is summed over the modules and the runs
+    EXPECT(v.at("summary").size() == 1);
+    EXPECT(v.at("summary").front().at("pass").to<std::string>() == "dead_code_elimination");
+}
+
+TEST_CASE(to_chrome_trace)
+{
+    auto p = create_program();
+    migraphx::compile_profile profile;
+    migraphx::run_passes(p, {migraphx::dead_code_elimination{}}, {}, &profile);
+    auto events = profile.to_chrome_trace().at("traceEvents");
+    // A complete event for each record and a name for the program and the main module
+    EXPECT(events.size() == 3);
+    std::size_t complete = std::count_if(events.begin(), events.end(), [](const auto& e) {
+        return e.at("ph").template to<std::string>() == "X";
+    });
+    EXPECT(complete == 1);
+    auto main_event = events.front();
+    EXPECT(main_event.at("name").to<std::string>() == "dead_code_elimination");
+    EXPECT(main_event.contains("ts"));
+    EXPECT(main_event.contains("dur"));
+    EXPECT(main_event.at("tid").to<std::size_t>() == 1);
+    EXPECT(events.back().at("args").at("name").to<std::string>() == "main");
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
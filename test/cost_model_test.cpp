@@ -0,0 +1,96 @@
+#include <migraphx/cost_model.hpp>
+#include <migraphx/float_equal.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/ref/target.hpp>
+#include <migraphx/stringutils.hpp>
+#include <sstream>
+
+#include <test.hpp>
+
+TEST_CASE(convolution_flops)
+{
+    migraphx::module m;
+    auto x    = m.add_parameter("x", {migraphx::shape::float_type, {1, 8, 16, 16}});
+    auto w    = m.add_parameter("w", {migraphx::shape::float_type, {4, 8, 3, 3}});
+    auto conv = m.add_instruction(migraphx::make_op("convolution"), x, w);
+    auto cost = migraphx::estimate_cost(conv);
+    // Each of the 4x14x14 outputs is a multiply-add over 8x3x3 inputs
+    EXPECT(migraphx::float_equal(cost.flops, 2.0 * 4 * 14 * 14 * 8 * 3 * 3));
+    EXPECT(migraphx::float_equal(cost.bytes, 4.0 * (8 * 16 * 16 + 4 * 8 * 3 * 3 + 4 * 14 * 14)));
+}
+
+TEST_CASE(dot_flops)
+{
+    migraphx::module m;
+    auto a    = m.add_parameter("a", {migraphx::shape::float_type, {2, 16, 32}});
+    auto b    = m.add_parameter("b", {migraphx::shape::float_type, {2, 32, 8}});
+    auto dot  = m.add_instruction(migraphx::make_op("dot"), a, b);
+    auto cost = migraphx::estimate_cost(dot);
+    EXPECT(migraphx::float_equal(cost.flops, 2.0 * 2 * 16 * 8 * 32));
+}
+
+TEST_CASE(roofline_weight)
+{
+    migraphx::module m;
+    auto x     = m.add_parameter("x", {migraphx::shape::float_type, {1, 64, 56, 56}});
+    auto w1    = m.add_parameter("w1", {migraphx::shape::float_type, {64, 64, 1, 1}});
+    auto w7    = m.add_parameter("w7", {migraphx::shape::float_type, {64, 64, 7, 7}});
+    auto conv1 = m.add_instruction(migraphx::make_op("convolution"), x, w1);
+    auto conv7 = m.add_instruction(migraphx::make_op("convolution", {{"padding", {3, 3}}}), x, w7);
+    auto relu  = m.add_instruction(migraphx::make_op("relu"), conv7);
+    migraphx::cost_model cost{1.0e12, 1.0e11};
+    EXPECT(not cost.empty());
+    EXPECT(migraphx::cost_model{}.empty());
+    EXPECT(cost.weight(conv7) > 10 * cost.weight(conv1));
+    EXPECT(cost.weight(relu) < cost.weight(conv1));
+    EXPECT(cost.weight(relu) >= 1);
+}
+
+TEST_CASE(read_perf_report)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {4, 8}});
+    auto y   = mm->add_parameter("y", {migraphx::shape::float_type, {8, 2}});
+    auto dot = mm->add_instruction(migraphx::make_op("dot"), x, y);
+    mm->add_instruction(migraphx::make_op("relu"), dot);
+    p.compile(migraphx::ref::target{});
+    std::stringstream ss;
+    migraphx::parameter_map params;
+    for(auto&& s : p.get_parameter_shapes())
+        params[s.first] = migraphx::generate_argument(s.second);
+    p.perf_report(ss, 2, params);
+
+    auto times = migraphx::read_perf_report(ss);
+    migraphx::cost_model cost;
+    cost.times = times;
+    for(auto ins : migraphx::iterator_for(*mm))
+    {
+        if(migraphx::starts_with(ins->name(), "@"))
+            continue;
+        auto key = migraphx::cost_key(ins);
+        EXPECT(migraphx::contains(times, key));
+        EXPECT(migraphx::float_equal(cost.time(ins), times.at(key) * 1000));
+    }
+}
+
+TEST_CASE(read_perf_report_lines)
+{
+    std::stringstream ss;
+    ss << "@0 = @param:x -> float_type, {2}, {1}: 0.001ms, 1%\n";
+    ss << "@1 = ref::op[axis=1](@0) -> float_type, {2}, {1}: 2ms, 50%\n";
+    ss << "@2 = ref::op[axis=1](@1) -> float_type, {2}, {1}: 4ms, 49%\n";
+    ss << "@3 = @return(@2)\n";
+    ss << "Summary:\n";
+    ss << "ref::op: 6ms, 99%\n";
+    auto times = migraphx::read_perf_report(ss);
+    EXPECT(times.size() == 2);
+    EXPECT(migraphx::float_equal(times.at("ref::op[axis=1] -> float_type, {2}, {1}"), 3.0));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,133 @@
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/cpu/numa.hpp>
+#include <migraphx/ranges.hpp>
+#include <sched.h>
+#include <thread>
+#include <test.hpp>
+
+static bool unique_cpus(std::vector<std::size_t> cpus)
+{
+    std::sort(cpus.begin(), cpus.end());
+    return std::adjacent_find(cpus.begin(), cpus.end()) == cpus.end();
+}
+
+static cpu_set_t get_affinity()
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    sched_getaffinity(0, sizeof(set), &set);
+    return set;
+}
+
+TEST_CASE(parse_cpu_list)
+{
+    using migraphx::cpu::parse_cpu_list;
+    EXPECT(parse_cpu_list("0-3,8-11\n") == std::vector<std::size_t>{0, 1, 2, 3, 8, 9, 10, 11});
+    EXPECT(parse_cpu_list("0,2,5") == std::vector<std::size_t>{0, 2, 5});
+    EXPECT(parse_cpu_list("7") == std::vector<std::size_t>{7});
+    EXPECT(parse_cpu_list("1-2,,4") == std::vector<std::size_t>{1, 2, 4});
+    EXPECT(parse_cpu_list("").empty());
+    EXPECT(parse_cpu_list("\n").empty());
+}
+
+TEST_CASE(numa_cpus_none)
+{
+    std::vector<std::vector<std::size_t>> nodes = {{0, 1}, {2, 3}};
+    EXPECT(migraphx::cpu::get_numa_cpus(migraphx::cpu::numa_policy::none, nodes, 0).empty());
+    EXPECT(migraphx::cpu::get_numa_cpus(migraphx::cpu::numa_policy::none).empty());
+}
+
+TEST_CASE(numa_cpus_spread)
+{
+    // The nodes take turns until the cpus of every node are used
+    std::vector<std::vector<std::size_t>> nodes = {{0, 1, 2}, {4, 5}, {}};
+    EXPECT(migraphx::cpu::get_numa_cpus(migraphx::cpu::numa_policy::spread, nodes, 0) ==
+           std::vector<std::size_t>{0, 4, 1, 5, 2});
+}
+
+TEST_CASE(numa_cpus_local)
+{
+    std::vector<std::vector<std::size_t>> nodes = {{0, 1, 2}, {4, 5}, {}};
+    EXPECT(migraphx::cpu::get_numa_cpus(migraphx::cpu::numa_policy::local, nodes, 1) ==
+           std::vector<std::size_t>{4, 5});
+    EXPECT(test::throws([&] {
+        migraphx::cpu::get_numa_cpus(migraphx::cpu::numa_policy::local, nodes, 2);
+    }));
+    EXPECT(test::throws([&] {
+        migraphx::cpu::get_numa_cpus(migraphx::cpu::numa_policy::local, nodes, 3);
+    }));
+}
+
+TEST_CASE(numa_cpus_host)
+{
+    auto nodes = migraphx::cpu::get_numa_nodes();
+    EXPECT(not nodes.empty());
+    std::size_t n = 0;
+    for(const auto& cpus : nodes)
+        n += cpus.size();
+    // Each allowed cpu of the host is used once
+    auto cpus = migraphx::cpu::get_numa_cpus(migraphx::cpu::numa_policy::spread);
+    EXPECT(cpus.size() == n);
+    EXPECT(unique_cpus(cpus));
+    auto affinity = get_affinity();
+    EXPECT(migraphx::all_of(cpus, [&](auto cpu) { return CPU_ISSET(cpu, &affinity); }));
+}
+
+TEST_CASE(pin_keeps_caller_affinity)
+{
+    migraphx::cpu::context ctx;
+    ctx.policy = migraphx::cpu::numa_policy::spread;
+    ctx.cpus   = migraphx::cpu::get_numa_cpus(ctx.policy);
+    auto check = [&] {
+        auto before = get_affinity();
+        std::vector<int> x(4096);
+        ctx.bulk_execute(x.size(), 1, [&](auto start, auto end) {
+            for(auto i = start; i < end; i++)
+                x[i] = 1;
+        });
+        auto after = get_affinity();
+        EXPECT(CPU_EQUAL(&before, &after));
+        EXPECT(std::all_of(x.begin(), x.end(), [](int i) { return i == 1; }));
+    };
+    // Programs can run from several threads at the same time
+    std::thread t1{check};
+    std::thread t2{check};
+    t1.join();
+    t2.join();
+    check();
+}
+
+TEST_CASE(pin_caller_in_region)
+{
+    // The calling thread runs the first chunk on the first cpu, and gets its affinity back after
+    migraphx::cpu::context ctx;
+    ctx.policy  = migraphx::cpu::numa_policy::spread;
+    ctx.cpus    = migraphx::cpu::get_numa_cpus(ctx.policy);
+    auto before = get_affinity();
+    cpu_set_t first;
+    CPU_ZERO(&first);
+    ctx.bulk_execute(ctx.cpus.size() * 256, 256, [&](auto start, auto) {
+        if(start == 0)
+            first = get_affinity();
+    });
+    auto after = get_affinity();
+    EXPECT(CPU_COUNT(&first) == 1);
+    EXPECT(CPU_ISSET(ctx.cpus.front(), &first));
+    EXPECT(CPU_EQUAL(&before, &after));
+}
+
+TEST_CASE(context_policy)
+{
+    migraphx::cpu::context ctx;
+    ctx.from_value({{"numa_policy", "spread"}});
+    EXPECT(to_string(ctx.policy) == "spread");
+    EXPECT(ctx.cpus == migraphx::cpu::get_numa_cpus(migraphx::cpu::numa_policy::spread));
+    EXPECT(ctx.to_value().at("numa_policy").to<std::string>() == "spread");
+    ctx.from_value(migraphx::value{});
+    EXPECT(to_string(ctx.policy) == "spread");
+    ctx.from_value({{"numa_policy", "none"}});
+    EXPECT(ctx.cpus.empty());
+    EXPECT(test::throws([&] { ctx.from_value({{"numa_policy", "nearest"}}); }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,126 @@
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/cpu/tune_ops.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/tmp_dir.hpp>
+#include <test.hpp>
+
+static migraphx::module create_module(std::size_t pad = 0,
+                                      const std::string& algo = "convolution_auto")
+{
+    migraphx::module m;
+    auto x   = m.add_parameter("x", {migraphx::shape::float_type, {1, 8, 14, 14}});
+    auto w   = m.add_parameter("w", {migraphx::shape::float_type, {16, 8, 3, 3}});
+    auto out = m.add_parameter(
+        "output", {migraphx::shape::float_type, {1, 16, 12 + 2 * pad, 12 + 2 * pad}});
+    m.add_instruction(migraphx::make_op("dnnl::convolution",
+                                        {{"padding", {pad, pad, pad, pad}}, {"algo", algo}}),
+                      x,
+                      w,
+                      out);
+    return m;
+}
+
+static migraphx::instruction_ref get_convolution(migraphx::module& m) { return std::prev(m.end()); }
+
+static std::string get_algo(migraphx::module& m)
+{
+    return get_convolution(m)->get_operator().to_value().at("algo").to<std::string>();
+}
+
+static void write_db(const std::string& file, const migraphx::value& db)
+{
+    auto s = migraphx::to_json_string(db);
+    migraphx::write_buffer(file, s.data(), s.size());
+}
+
+static migraphx::value read_db(const std::string& file)
+{
+    return migraphx::from_json_string(migraphx::read_string(file));
+}
+
+TEST_CASE(problem_key_ignores_algo)
+{
+    auto m1  = create_module(0, "convolution_auto");
+    auto m2  = create_module(0, "convolution_direct");
+    auto m3  = create_module(1, "convolution_auto");
+    auto key = migraphx::cpu::problem_key(get_convolution(m1));
+    EXPECT(key == migraphx::cpu::problem_key(get_convolution(m2)));
+    EXPECT(key != migraphx::cpu::problem_key(get_convolution(m3)));
+    EXPECT(migraphx::contains(key, "dnnl::convolution"));
+    EXPECT(not migraphx::contains(key, "algo"));
+}
+
+TEST_CASE(tuning_db_key)
+{
+    const auto* v = dnnl::version();
+    auto key      = migraphx::cpu::tuning_db_key();
+    EXPECT(migraphx::starts_with(key,
+                                 "dnnl-" + std::to_string(v->major) + "." +
+                                     std::to_string(v->minor) + "." + std::to_string(v->patch) +
+                                     "-isa"));
+}
+
+TEST_CASE(tuning_db_round_trip)
+{
+    migraphx::tmp_dir td{"tune_ops"};
+    auto file = (td.path / "tuning.json").string();
+    migraphx::cpu::context ctx;
+
+    auto m1 = create_module();
+    migraphx::run_passes(m1, {migraphx::cpu::tune_ops{&ctx, true, file}});
+    auto db = read_db(file);
+    EXPECT(db.size() == 1);
+    EXPECT(db.contains(migraphx::cpu::tuning_db_key()));
+    const auto& problems = db.at(migraphx::cpu::tuning_db_key());
+    EXPECT(problems.size() == 1);
+    auto key  = migraphx::cpu::problem_key(get_convolution(m1));
+    auto algo = problems.at(key).to<std::string>();
+    EXPECT(get_algo(m1) == algo);
+
+    // The algorithm is reloaded without tuning
+    auto m2 = create_module();
+    migraphx::run_passes(m2, {migraphx::cpu::tune_ops{&ctx, false, file}});
+    EXPECT(get_algo(m2) == algo);
+
+    // The entry of the database is used, rather than a new tuning result
+    auto other = algo == "convolution_direct" ? "convolution_auto" : "convolution_direct";
+    db[migraphx::cpu::tuning_db_key()][key] = other;
+    write_db(file, db);
+    auto m3 = create_module();
+    migraphx::run_passes(m3, {migraphx::cpu::tune_ops{&ctx, true, file}});
+    EXPECT(get_algo(m3) == other);
+}
+
+TEST_CASE(tuning_db_keyed_by_isa)
+{
+    migraphx::tmp_dir td{"tune_ops"};
+    auto file = (td.path / "tuning.json").string();
+    migraphx::cpu::context ctx;
+
+    // An entry of another version of dnnl or another instruction set is not used
+    auto m1            = create_module();
+    auto key           = migraphx::cpu::problem_key(get_convolution(m1));
+    migraphx::value db = {{"dnnl-0.0.0-isa0", {{key, "convolution_direct"}}}};
+    write_db(file, db);
+    migraphx::run_passes(m1, {migraphx::cpu::tune_ops{&ctx, false, file}});
+    EXPECT(get_algo(m1) == "convolution_auto");
+    EXPECT(read_db(file) == db);
+
+    // Tuning adds the entries of this version next to the others
+    auto m2 = create_module();
+    migraphx::run_passes(m2, {migraphx::cpu::tune_ops{&ctx, true, file}});
+    auto result = read_db(file);
+    EXPECT(result.size() == 2);
+    EXPECT(result.at("dnnl-0.0.0-isa0") == db.at("dnnl-0.0.0-isa0"));
+    EXPECT(result.at(migraphx::cpu::tuning_db_key()).contains(key));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -54,6 +54,11 @@ struct concat_test_optimization
     }
 };
 
+struct concat_test_strided_optimization : concat_test_optimization
+{
+    bool supports_strided() const { return true; }
+};
+
 void run_pass(migraphx::module& m)
 {
     migraphx::run_passes(m,
@@ -61,6 +66,13 @@ void run_pass(migraphx::module& m)
                           migraphx::dead_code_elimination{}});
 }
 
+void run_strided_pass(migraphx::module& m)
+{
+    migraphx::run_passes(m,
+                         {migraphx::eliminate_concat{concat_test_strided_optimization{}},
+                          migraphx::dead_code_elimination{}});
+}
+
 struct allocate
 {
     migraphx::shape s{};
@@ -102,6 +114,23 @@ struct simple_op
     int output_alias(const std::vector<migraphx::shape>&) const { return 0; }
 };
 
+struct standard_op
+{
+    std::string name() const { return "standard_op"; }
+    migraphx::shape compute_shape(const std::vector<migraphx::shape>& inputs) const
+    {
+        migraphx::check_shapes{inputs, *this}.has(1);
+        return {inputs.at(0).type(), inputs.at(0).lens()};
+    }
+    migraphx::argument compute(migraphx::context&,
+                               const migraphx::shape&,
+                               const std::vector<migraphx::argument>& args) const
+    {
+        return args.at(0);
+    }
+    int output_alias(const std::vector<migraphx::shape>&) const { return 0; }
+};
+
 template <class... Ts>
 migraphx::shape create_shape(Ts... xs)
 {
@@ -398,4 +427,67 @@ TEST_CASE(wont_work)
     EXPECT(m1 == m2);
 }
 
+TEST_CASE(strided)
+{
+    auto create_test_program = [] {
+        migraphx::module m;
+        auto a1 =
+            m.add_instruction(allocate{migraphx::shape{migraphx::shape::float_type, {2, 2, 8, 8}}});
+        auto m1 = m.add_instruction(simple_op{}, a1);
+        auto a2 =
+            m.add_instruction(allocate{migraphx::shape{migraphx::shape::float_type, {2, 3, 8, 8}}});
+        auto m2          = m.add_instruction(simple_op{}, a2);
+        std::size_t axis = 1;
+        auto a3          = m.add_instruction(
+            allocate{migraphx::shape{migraphx::shape::float_type, {2, 5, 8, 8}}});
+        m.add_instruction(concat(axis), m1, m2, a3);
+        return m;
+    };
+    auto create_control_program = [] {
+        migraphx::module m;
+        std::vector<std::size_t> strides = {320, 64, 8, 1};
+        auto a1                          = m.add_instruction(
+            allocate{migraphx::shape{migraphx::shape::float_type, {2, 5, 8, 8}}});
+        auto l1 = m.add_instruction(
+            load{migraphx::shape{migraphx::shape::float_type, {2, 2, 8, 8}, strides}, 0}, {a1});
+        auto m1 = m.add_instruction(simple_op{}, l1);
+        auto l2 = m.add_instruction(
+            load{migraphx::shape{migraphx::shape::float_type, {2, 3, 8, 8}, strides}, 512}, {a1});
+        auto m2 = m.add_instruction(simple_op{}, l2);
+        m.add_instruction(identity{}, {a1, m1, m2});
+        return m;
+    };
+
+    auto m1 = create_test_program();
+    auto m2 = create_control_program();
+    run_strided_pass(m1);
+
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(strided_standard_output)
+{
+    auto create_test_program = [] {
+        migraphx::module m;
+        auto a1 =
+            m.add_instruction(allocate{migraphx::shape{migraphx::shape::float_type, {2, 2, 8, 8}}});
+        auto m1 = m.add_instruction(simple_op{}, a1);
+        auto a2 =
+            m.add_instruction(allocate{migraphx::shape{migraphx::shape::float_type, {2, 3, 8, 8}}});
+        auto m2          = m.add_instruction(standard_op{}, a2);
+        std::size_t axis = 1;
+        auto a3          = m.add_instruction(
+            allocate{migraphx::shape{migraphx::shape::float_type, {2, 5, 8, 8}}});
+        m.add_instruction(concat(axis), m1, m2, a3);
+        return m;
+    };
+    auto create_control_program = create_test_program;
+
+    auto m1 = create_test_program();
+    auto m2 = create_control_program();
+    run_strided_pass(m1);
+
+    EXPECT(m1 == m2);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
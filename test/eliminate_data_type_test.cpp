@@ -68,4 +68,20 @@ TEST_CASE(quant)
     EXPECT(mm1 == mm2);
 }
 
+TEST_CASE(dequant_dot)
+{
+    // The quantized weights are kept, since the op dequantizes them itself
+    migraphx::module mm1;
+    {
+        auto a = mm1.add_parameter("a", {migraphx::shape::float_type, {2, 16}});
+        auto b = mm1.add_parameter("b", {migraphx::shape::uint8_type, {4, 8}});
+        auto s = mm1.add_parameter("s", {migraphx::shape::float_type, {4, 2}});
+        mm1.add_instruction(
+            migraphx::make_op("dequant_dot", {{"bits", 4}, {"group_size", 8}}), a, b, s);
+    }
+    auto mm2 = mm1;
+    run_pass(mm1, {migraphx::shape::int8_type, migraphx::shape::uint8_type});
+    EXPECT(mm1 == mm2);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,103 @@
+#include <migraphx/literal_pool.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include "test.hpp"
+
+migraphx::literal create_literal(unsigned long seed)
+{
+    return migraphx::generate_literal({migraphx::shape::float_type, {64, 32}}, seed);
+}
+
+migraphx::program create_program(const migraphx::literal& l)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", l.get_shape());
+    auto w   = mm->add_literal(l);
+    mm->add_instruction(migraphx::make_op("add"), x, w);
+    return p;
+}
+
+const char* get_literal_data(const migraphx::program& p)
+{
+    const auto* mm = p.get_main_module();
+    for(auto ins : migraphx::iterator_for(*mm))
+    {
+        if(ins->name() == "@literal")
+            return ins->get_literal().data();
+    }
+    return nullptr;
+}
+
+TEST_CASE(share_identical)
+{
+    migraphx::literal_pool pool;
+    auto l1 = pool.add(create_literal(1));
+    auto l2 = pool.add(create_literal(1));
+    auto l3 = pool.add(create_literal(2));
+    EXPECT(l1 == l2);
+    EXPECT(l1.data() == l2.data());
+    EXPECT(l1.data() != l3.data());
+
+    auto stats = pool.get_stats();
+    EXPECT(stats.lookups == 3);
+    EXPECT(stats.hits == 1);
+    EXPECT(stats.bytes_saved == l1.get_shape().bytes());
+    EXPECT(stats.buffers == 2);
+    EXPECT(stats.bytes == 2 * l1.get_shape().bytes());
+}
+
+TEST_CASE(different_bytes)
+{
+    migraphx::literal_pool pool;
+    auto l1 = create_literal(9);
+    std::vector<char> data(l1.data(), l1.data() + l1.get_shape().bytes());
+    data[100]++;
+    auto p1 = pool.add(l1);
+    auto p2 = pool.add(migraphx::literal{l1.get_shape(), data.data()});
+    EXPECT(p1.data() != p2.data());
+    EXPECT(pool.get_stats().hits == 0);
+}
+
+TEST_CASE(share_different_shape)
+{
+    migraphx::literal_pool pool;
+    auto l1 = pool.add(create_literal(3));
+    migraphx::shape s{migraphx::shape::float_type, {32, 64}};
+    auto l2 = pool.add(migraphx::literal{s, l1.data()});
+    EXPECT(l2.get_shape() == s);
+    EXPECT(l1.data() == l2.data());
+}
+
+TEST_CASE(pooled_literal)
+{
+    migraphx::literal_pool pool;
+    auto l1 = pool.add(create_literal(4));
+    auto l2 = pool.add(l1);
+    EXPECT(l1.data() == l2.data());
+    EXPECT(pool.get_stats().hits == 0);
+    EXPECT(pool.get_stats().buffers == 1);
+}
+
+TEST_CASE(separate_pools)
+{
+    // Literals are only shared within a pool
+    migraphx::literal_pool pool1;
+    migraphx::literal_pool pool2;
+    auto l1 = pool1.add(create_literal(5));
+    auto l2 = pool2.add(create_literal(5));
+    EXPECT(l1.data() != l2.data());
+}
+
+TEST_CASE(add_literal)
+{
+    // Modules do not share literals unless they are pooled
+    auto p1 = create_program(create_literal(6));
+    auto p2 = create_program(create_literal(6));
+    EXPECT(get_literal_data(p1) != get_literal_data(p2));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -1356,6 +1356,21 @@ TEST_CASE(external_data_diff_path_test)
     EXPECT(p == prog);
 }
 
+TEST_CASE(external_data_offset_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    auto a = mm->add_literal(migraphx::literal{s, {1, 2, 3, 4, 5, 6}});
+    auto b = mm->add_literal(migraphx::literal{s, {7, 8, 9, 10, 11, 12}});
+    auto x = mm->add_parameter("x", s);
+    auto t = mm->add_instruction(migraphx::make_op("add"), x, a);
+    mm->add_instruction(migraphx::make_op("add"), t, b);
+
+    auto prog = optimize_onnx("external_data_offset_test.onnx");
+    EXPECT(p == prog);
+}
+
 TEST_CASE(eyelike_default_test)
 {
     migraphx::program p;
@@ -5426,6 +5441,17 @@ TEST_CASE(variable_batch_user_input_test)
     EXPECT(p == prog);
 }
 
+TEST_CASE(variable_batch_buckets_test)
+{
+    auto buckets = migraphx::parse_onnx_buckets("variable_batch_test.onnx", {1, 4});
+    EXPECT(buckets.get_batch_sizes() == std::vector<std::size_t>{1, 4});
+    EXPECT(buckets.get_batched_parameter_names() == std::vector<std::string>{"0"});
+    EXPECT(buckets.get(1).get_parameter_shape("0") ==
+           migraphx::shape{migraphx::shape::float_type, {1, 3, 16, 16}});
+    EXPECT(buckets.get(4).get_parameter_shape("0") ==
+           migraphx::shape{migraphx::shape::float_type, {4, 3, 16, 16}});
+}
+
 TEST_CASE(variable_batch_leq_zero_test)
 {
     migraphx::program p;
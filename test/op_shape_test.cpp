@@ -192,6 +192,40 @@ TEST_CASE(deconvolution_shape)
         weights_3d);
 }
 
+TEST_CASE(dequant_dot_shape)
+{
+    migraphx::shape a{migraphx::shape::float_type, {2, 3, 10}};
+    migraphx::shape b8{migraphx::shape::int8_type, {4, 10}};
+    migraphx::shape b4{migraphx::shape::uint8_type, {4, 5}};
+    migraphx::shape scales{migraphx::shape::float_type, {4, 1}};
+    migraphx::shape group_scales{migraphx::shape::float_type, {4, 3}};
+    migraphx::shape output{migraphx::shape::float_type, {2, 3, 4}};
+    expect_shape(output, migraphx::make_op("dequant_dot"), a, b8, scales);
+    expect_shape(output,
+                 migraphx::make_op("dequant_dot", {{"bits", 8}, {"group_size", 4}}),
+                 a,
+                 b8,
+                 group_scales);
+    expect_shape(output,
+                 migraphx::make_op("dequant_dot", {{"bits", 4}, {"group_size", 4}}),
+                 a,
+                 b4,
+                 group_scales);
+
+    throws_shape(migraphx::make_op("dequant_dot"), a, b4, scales);
+    throws_shape(migraphx::make_op("dequant_dot", {{"bits", 4}}), a, b8, scales);
+    throws_shape(migraphx::make_op("dequant_dot", {{"bits", 2}}), a, b8, scales);
+    throws_shape(migraphx::make_op("dequant_dot"), a, b8, group_scales);
+    throws_shape(migraphx::make_op("dequant_dot"),
+                 migraphx::shape{migraphx::shape::float_type, {2, 3, 8}},
+                 b8,
+                 scales);
+    throws_shape(migraphx::make_op("dequant_dot"),
+                 migraphx::shape{migraphx::shape::int32_type, {2, 3, 10}},
+                 b8,
+                 scales);
+}
+
 TEST_CASE(flatten_shape)
 {
     migraphx::shape input{migraphx::shape::float_type, {2, 4, 6, 8}};
@@ -0,0 +1,122 @@
+#include <migraphx/program_buckets.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/ref/target.hpp>
+#include <migraphx/make_op.hpp>
+#include "test.hpp"
+
+migraphx::program create_program(std::size_t batch_size)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {batch_size, 3}};
+    auto x  = mm->add_parameter("x", s);
+    auto y  = mm->add_parameter("y", {migraphx::shape::float_type, {3}});
+    auto w  = mm->add_literal(migraphx::literal{{migraphx::shape::float_type, {3}}, {1, 2, 3}});
+    auto yw = mm->add_instruction(migraphx::make_op("add"), y, w);
+    auto b =
+        mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), yw);
+    auto sum = mm->add_instruction(migraphx::make_op("add"), x, b);
+    mm->add_return({sum, yw});
+    return p;
+}
+
+migraphx::program_buckets create_buckets(std::vector<std::size_t> batch_sizes)
+{
+    migraphx::program_buckets buckets;
+    for(auto batch_size : batch_sizes)
+        buckets.insert(batch_size, create_program(batch_size));
+    return buckets;
+}
+
+std::vector<const char*> get_literal_data(const migraphx::program& p)
+{
+    std::vector<const char*> result;
+    const auto* mm = p.get_main_module();
+    for(auto ins : migraphx::iterator_for(*mm))
+    {
+        if(ins->name() == "@literal")
+            result.push_back(ins->get_literal().data());
+    }
+    return result;
+}
+
+TEST_CASE(select_bucket)
+{
+    auto buckets = create_buckets({4, 1, 16});
+    EXPECT(buckets.size() == 3);
+    EXPECT(buckets.get_batch_sizes() == std::vector<std::size_t>{1, 4, 16});
+    EXPECT(buckets.select(1) == 1);
+    EXPECT(buckets.select(2) == 4);
+    EXPECT(buckets.select(4) == 4);
+    EXPECT(buckets.select(5) == 16);
+    EXPECT(test::throws([&] { buckets.select(17); }));
+    EXPECT(test::throws([&] { buckets.get(2); }));
+}
+
+TEST_CASE(batched_parameters)
+{
+    auto buckets = create_buckets({2, 4});
+    EXPECT(buckets.get_batched_parameter_names() == std::vector<std::string>{"x"});
+}
+
+TEST_CASE(share_literals)
+{
+    auto buckets = create_buckets({2, 4});
+    EXPECT(get_literal_data(buckets.get(2)) != get_literal_data(buckets.get(4)));
+    buckets.share_literals();
+    EXPECT(get_literal_data(buckets.get(2)) == get_literal_data(buckets.get(4)));
+    EXPECT(buckets.get(2) == create_program(2));
+    EXPECT(buckets.get(4) == create_program(4));
+}
+
+TEST_CASE(eval_padded)
+{
+    auto buckets = create_buckets({2, 4});
+    buckets.compile(migraphx::ref::target{});
+
+    std::vector<float> x_data = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<float> y_data = {1, 1, 1};
+    migraphx::parameter_map params;
+    params["x"] = migraphx::argument{{migraphx::shape::float_type, {3, 3}}, x_data.data()};
+    params["y"] = migraphx::argument{{migraphx::shape::float_type, {3}}, y_data.data()};
+    auto results = buckets.eval(params);
+    EXPECT(results.size() == 2);
+    EXPECT(results[0].get_shape().lens() == std::vector<std::size_t>{3, 3});
+    EXPECT(results[1].get_shape().lens() == std::vector<std::size_t>{3});
+
+    std::vector<float> sum;
+    results[0].visit([&](auto output) { sum.assign(output.begin(), output.end()); });
+    std::vector<float> gold = {2, 4, 6, 5, 7, 9, 8, 10, 12};
+    EXPECT(sum == gold);
+}
+
+TEST_CASE(eval_exact)
+{
+    auto buckets = create_buckets({2, 4});
+    buckets.compile(migraphx::ref::target{});
+
+    std::vector<float> x_data = {0, 1, 2, 3, 4, 5};
+    std::vector<float> y_data = {0, 0, 0};
+    migraphx::parameter_map params;
+    params["x"] = migraphx::argument{{migraphx::shape::float_type, {2, 3}}, x_data.data()};
+    params["y"] = migraphx::argument{{migraphx::shape::float_type, {3}}, y_data.data()};
+    auto results = buckets.eval(params);
+    std::vector<float> sum;
+    results[0].visit([&](auto output) { sum.assign(output.begin(), output.end()); });
+    std::vector<float> gold = {1, 3, 5, 4, 6, 8};
+    EXPECT(sum == gold);
+}
+
+TEST_CASE(eval_too_large)
+{
+    auto buckets = create_buckets({2, 4});
+    buckets.compile(migraphx::ref::target{});
+
+    migraphx::parameter_map params;
+    params["x"] = migraphx::argument{{migraphx::shape::float_type, {5, 3}}};
+    params["y"] = migraphx::argument{{migraphx::shape::float_type, {3}}};
+    EXPECT(test::throws([&] { buckets.eval(params); }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
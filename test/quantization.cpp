@@ -1,9 +1,13 @@
 #include <iostream>
+#include <set>
 #include <vector>
+#include <migraphx/float_equal.hpp>
 #include <migraphx/literal.hpp>
 #include <migraphx/operators.hpp>
 #include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
 #include <migraphx/generate.hpp>
+#include <migraphx/ranges.hpp>
 #include <migraphx/ref/target.hpp>
 #include <migraphx/verify.hpp>
 #include <migraphx/apply_alpha_beta.hpp>
@@ -19,6 +23,7 @@
 #include <migraphx/onnx.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/serialize.hpp>
+#include <migraphx/json.hpp>
 #include <migraphx/argument.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/shape.hpp>
@@ -1257,4 +1262,266 @@ TEST_CASE(test_op_capture)
     EXPECT(migraphx::verify_range(vec, cap_vec));
 }
 
+static std::size_t literal_bytes(const migraphx::program& p)
+{
+    std::size_t bytes = 0;
+    for(auto ins : migraphx::iterator_for(*p.get_main_module()))
+    {
+        if(ins->name() == "@literal")
+            bytes += ins->get_shape().bytes();
+    }
+    return bytes;
+}
+
+static migraphx::program create_weights_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape sa{migraphx::shape::float_type, {2, 4, 64}};
+    migraphx::shape sw{migraphx::shape::float_type, {32, 64}};
+    auto a  = mm->add_parameter("a", sa);
+    auto w  = mm->add_literal(migraphx::generate_literal(sw, 1));
+    auto wt = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0}}}), w);
+    auto wb =
+        mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", {2, 64, 32}}}), wt);
+    mm->add_instruction(migraphx::make_op("dot"), a, wb);
+    return p;
+}
+
+static double quantize_weights_error(migraphx::program p1, migraphx::program p2)
+{
+    p1.compile(migraphx::ref::target{});
+    p2.compile(migraphx::ref::target{});
+    migraphx::parameter_map params;
+    params["a"]  = migraphx::generate_argument({migraphx::shape::float_type, {2, 4, 64}}, 2);
+    auto result1 = p1.eval(params).back();
+    auto result2 = p2.eval(params).back();
+    std::vector<float> v1;
+    std::vector<float> v2;
+    result1.visit([&](auto output) { v1.assign(output.begin(), output.end()); });
+    result2.visit([&](auto output) { v2.assign(output.begin(), output.end()); });
+    return migraphx::rms_range(v1, v2);
+}
+
+TEST_CASE(quantize_weights_int8)
+{
+    auto p1 = create_weights_program();
+    auto p2 = p1;
+    migraphx::quantize_weights(p2);
+    auto* mm = p2.get_main_module();
+    EXPECT(std::none_of(mm->begin(), mm->end(), [](auto& ins) { return ins.name() == "dot"; }));
+    auto qdot = std::find_if(
+        mm->begin(), mm->end(), [](auto& ins) { return ins.name() == "dequant_dot"; });
+    EXPECT(bool{qdot != mm->end()});
+    EXPECT(qdot->inputs()[1]->get_shape() ==
+           migraphx::shape{migraphx::shape::int8_type, {32, 64}});
+    EXPECT(literal_bytes(p2) * 3 < literal_bytes(p1));
+    EXPECT(quantize_weights_error(p1, p2) < 0.01);
+}
+
+TEST_CASE(quantize_weights_int4)
+{
+    auto p1 = create_weights_program();
+    auto p2 = p1;
+    migraphx::quantize_weights(p2, 4, 16);
+    auto* mm  = p2.get_main_module();
+    auto qdot = std::find_if(
+        mm->begin(), mm->end(), [](auto& ins) { return ins.name() == "dequant_dot"; });
+    EXPECT(bool{qdot != mm->end()});
+    EXPECT(qdot->inputs()[1]->get_shape() ==
+           migraphx::shape{migraphx::shape::uint8_type, {32, 32}});
+    EXPECT(qdot->inputs()[2]->get_shape() ==
+           migraphx::shape{migraphx::shape::float_type, {32, 4}});
+    EXPECT(literal_bytes(p2) * 5 < literal_bytes(p1));
+    EXPECT(quantize_weights_error(p1, p2) < 0.1);
+
+    // The packed weights and the attributes are kept when the program is serialized
+    migraphx::program p3;
+    p3.from_value(p2.to_value());
+    EXPECT(literal_bytes(p3) == literal_bytes(p2));
+    EXPECT(migraphx::float_equal(quantize_weights_error(p2, p3), 0.0));
+}
+
+TEST_CASE(quantize_weights_skip_parameters)
+{
+    migraphx::program p1;
+    auto* mm = p1.get_main_module();
+    auto a   = mm->add_parameter("a", {migraphx::shape::float_type, {4, 8}});
+    auto b   = mm->add_parameter("b", {migraphx::shape::float_type, {8, 2}});
+    mm->add_instruction(migraphx::make_op("dot"), a, b);
+    auto p2 = p1;
+    migraphx::quantize_weights(p2);
+    EXPECT(p1 == p2);
+    EXPECT(test::throws([&] { migraphx::quantize_weights(p2, 2); }));
+}
+
+TEST_CASE(fp16_plan)
+{
+    auto create_program = [] {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+        auto x   = mm->add_parameter("x", s);
+        auto y   = mm->add_parameter("y", s);
+        auto add = mm->add_instruction(migraphx::make_op("add"), x, y);
+        auto sub = mm->add_instruction(migraphx::make_op("sub"), add, y);
+        mm->add_return({sub});
+        return p;
+    };
+
+    auto plan = [](const std::string& module_name, std::size_t index, const std::string& op) {
+        migraphx::value converted = migraphx::value::array{};
+        converted.push_back({{"module", module_name}, {"index", index}, {"operator", op}});
+        return migraphx::value{{"converted", converted}};
+    };
+
+    auto p1 = create_program();
+    auto p2 = create_program();
+    // The sub instruction follows the two parameters and the add
+    migraphx::quantize_fp16_plan(p1, plan("main", 3, "sub"));
+    migraphx::quantize_fp16(p2, {"sub"});
+    EXPECT(p1 == p2);
+
+    auto p3 = create_program();
+    migraphx::quantize_fp16_plan(p3, {{"converted", migraphx::value::array{}}});
+    EXPECT(p3 == create_program());
+
+    auto p4 = create_program();
+    EXPECT(test::throws([&] { migraphx::quantize_fp16_plan(p4, plan("main", 9, "sub")); }));
+    EXPECT(test::throws([&] { migraphx::quantize_fp16_plan(p4, plan("other", 3, "sub")); }));
+    // The plan was searched on a different program
+    EXPECT(test::throws([&] { migraphx::quantize_fp16_plan(p4, plan("main", 2, "sub")); }));
+    EXPECT(p4 == create_program());
+}
+
+TEST_CASE(fp16_search)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {4, 16}};
+    auto x   = mm->add_parameter("x", s);
+    auto two = mm->add_literal(migraphx::literal{s, std::vector<float>(s.elements(), 2)});
+    auto big = mm->add_literal(migraphx::literal{s, std::vector<float>(s.elements(), 4096)});
+    auto mul = mm->add_instruction(migraphx::make_op("mul"), x, two);
+    // The small values are lost when the sum is in fp16
+    auto add = mm->add_instruction(migraphx::make_op("add"), x, big);
+    auto sub = mm->add_instruction(migraphx::make_op("sub"), add, big);
+    mm->add_return({mul, sub});
+
+    std::vector<migraphx::parameter_map> calibration = {{{"x", migraphx::generate_argument(s, 0)}},
+                                                        {{"x", migraphx::generate_argument(s, 1)}}};
+    auto plan = migraphx::search_fp16_plan(p, migraphx::ref::target{}, calibration, 0.01);
+    auto ops  = [](const migraphx::value& layers) {
+        std::vector<std::string> result;
+        std::transform(layers.begin(), layers.end(), std::back_inserter(result), [](auto& l) {
+            return l.at("operator").template to<std::string>();
+        });
+        return result;
+    };
+    EXPECT(ops(plan.at("converted")) == std::vector<std::string>{"mul"});
+    EXPECT(migraphx::contains(ops(plan.at("kept")), "add"));
+    EXPECT(migraphx::contains(ops(plan.at("kept")), "sub"));
+    EXPECT(plan.at("error").to<double>() <= 0.01);
+
+    // The plan is reused from its JSON
+    auto p1 = p;
+    auto p2 = p;
+    migraphx::quantize_fp16_plan(p1, plan);
+    migraphx::quantize_fp16_plan(p2,
+                                 migraphx::from_json_string(migraphx::to_json_string(plan)));
+    EXPECT(p1 == p2);
+    EXPECT(std::any_of(p1.get_main_module()->begin(), p1.get_main_module()->end(), [](auto& ins) {
+        return ins.get_shape().type() == migraphx::shape::half_type;
+    }));
+
+    auto all = migraphx::search_fp16_plan(p, migraphx::ref::target{}, calibration, 1e9);
+    EXPECT(all.at("kept").empty());
+    EXPECT(test::throws([&] { migraphx::search_fp16_plan(p, migraphx::ref::target{}, {}, 0.01); }));
+}
+
+TEST_CASE(fp16_search_subgraph)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {4, 16}};
+    auto cond = mm->add_parameter("cond", {migraphx::shape::bool_type});
+    auto x    = mm->add_parameter("x", s);
+    auto big  = mm->add_literal(migraphx::literal{s, std::vector<float>(s.elements(), 4096)});
+    auto mul  = mm->add_instruction(migraphx::make_op("mul"), x, x);
+
+    auto* then_mod = p.create_module("then");
+    then_mod->add_return({then_mod->add_instruction(migraphx::make_op("add"), x, big)});
+    auto* else_mod = p.create_module("else");
+    else_mod->add_return({else_mod->add_instruction(migraphx::make_op("sub"), x, big)});
+    auto ret = mm->add_instruction(migraphx::make_op("if"), {cond}, {then_mod, else_mod});
+    auto r   = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), ret);
+    mm->add_return({mul, r});
+
+    auto calibration = [&](bool c) {
+        migraphx::argument arg{migraphx::shape{migraphx::shape::bool_type}};
+        arg.visit([&](auto v) { v.front() = c; });
+        return migraphx::parameter_map{{"cond", arg}, {"x", migraphx::generate_argument(s, 0)}};
+    };
+    // The instructions of the submodules are measured on the outputs of the program
+    auto plan = migraphx::search_fp16_plan(
+        p, migraphx::ref::target{}, {calibration(true), calibration(false)}, 1e9);
+    EXPECT(plan.at("kept").empty());
+    std::vector<std::string> modules;
+    for(const auto& l : plan.at("converted"))
+    {
+        modules.push_back(l.at("module").to<std::string>());
+        EXPECT(l.at("error").to<double>() >= 0);
+    }
+    EXPECT(migraphx::contains(modules, "main"));
+    EXPECT(migraphx::contains(modules, "then"));
+    EXPECT(migraphx::contains(modules, "else"));
+    auto p1 = p;
+    migraphx::quantize_fp16_plan(p1, plan);
+    EXPECT(p1 != p);
+}
+
+TEST_CASE(fp16_search_output_error)
+{
+    // The add loses the small values in fp16 by itself, but they never reach the output, so only
+    // the error of the output is compared with the budget
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {4, 16}};
+    auto x    = mm->add_parameter("x", s);
+    auto big  = mm->add_literal(migraphx::literal{s, std::vector<float>(s.elements(), 4096)});
+    auto zero = mm->add_literal(migraphx::literal{s, std::vector<float>(s.elements(), 0)});
+    auto add  = mm->add_instruction(migraphx::make_op("add"), x, big);
+    auto mul  = mm->add_instruction(migraphx::make_op("mul"), add, zero);
+    mm->add_return({mul});
+
+    std::vector<migraphx::parameter_map> calibration = {{{"x", migraphx::generate_argument(s, 0)}}};
+    auto plan = migraphx::search_fp16_plan(p, migraphx::ref::target{}, calibration, 0.01);
+    EXPECT(plan.at("kept").empty());
+    EXPECT(plan.at("converted").size() == 2);
+    EXPECT(plan.at("error").to<double>() <= 0.01);
+}
+
+TEST_CASE(fp16_search_batches)
+{
+    // The instructions of the main module are measured in several batches
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {4, 16}};
+    auto x   = mm->add_parameter("x", s);
+    auto one = mm->add_literal(migraphx::literal{s, std::vector<float>(s.elements(), 1)});
+    auto y   = x;
+    for(std::size_t i = 0; i < 40; i++)
+        y = mm->add_instruction(migraphx::make_op("add"), y, one);
+    mm->add_return({y});
+
+    std::vector<migraphx::parameter_map> calibration = {{{"x", migraphx::generate_argument(s, 0)}}};
+    auto plan = migraphx::search_fp16_plan(p, migraphx::ref::target{}, calibration, 1e9);
+    EXPECT(plan.at("kept").empty());
+    EXPECT(plan.at("converted").size() == 40);
+    std::set<std::size_t> indices;
+    for(const auto& l : plan.at("converted"))
+        indices.insert(l.at("index").to<std::size_t>());
+    EXPECT(indices.size() == 40);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -13,6 +13,7 @@
 #include <migraphx/verify.hpp>
 #include <migraphx/onnx.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/shape_for_each.hpp>
 
 #include <migraphx/serialize.hpp>
 
@@ -1236,6 +1237,46 @@ TEST_CASE(deconv_test)
     EXPECT(migraphx::verify_range(results_vector, gold));
 }
 
+TEST_CASE(dequant_dot_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape as{migraphx::shape::float_type, {2, 3}};
+    migraphx::shape bs{migraphx::shape::int8_type, {2, 3}};
+    migraphx::shape ss{migraphx::shape::float_type, {2, 1}};
+    auto a = mm->add_literal(migraphx::literal{as, {1, 2, 3, 4, 5, 6}});
+    auto b = mm->add_literal(migraphx::literal{bs, std::vector<int8_t>{1, 3, -5, -2, 4, 6}});
+    auto s = mm->add_literal(migraphx::literal{ss, {0.5, 2.0}});
+    mm->add_instruction(migraphx::make_op("dequant_dot"), a, b, s);
+    p.compile(migraphx::ref::target{});
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold = {-4, 48, -5.5, 96};
+    EXPECT(migraphx::verify_range(results_vector, gold));
+}
+
+TEST_CASE(dequant_dot_int4_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape as{migraphx::shape::float_type, {2, 3}};
+    migraphx::shape bs{migraphx::shape::uint8_type, {2, 2}};
+    migraphx::shape ss{migraphx::shape::float_type, {2, 2}};
+    auto a = mm->add_literal(migraphx::literal{as, {1, 2, 3, 4, 5, 6}});
+    // The weights {{1, -2}, {3, 4}, {-5, 6}} stored by column and packed in pairs of rows
+    auto b = mm->add_literal(migraphx::literal{bs, std::vector<uint8_t>{0x31, 0x0b, 0x4e, 0x06}});
+    auto s = mm->add_literal(migraphx::literal{ss, {0.5, 1.0, 2.0, -1.0}});
+    mm->add_instruction(
+        migraphx::make_op("dequant_dot", {{"bits", 4}, {"group_size", 2}}), a, b, s);
+    p.compile(migraphx::ref::target{});
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold = {-11.5, -6, -20.5, -12};
+    EXPECT(migraphx::verify_range(results_vector, gold));
+}
+
 TEST_CASE(dequantizelinear)
 {
     { /*uint8*/
@@ -4141,6 +4182,53 @@ TEST_CASE(reduce_sum_axis2)
     EXPECT(results_vector == gold);
 }
 
+TEST_CASE(reduce_layouts)
+{
+    // Covers reductions over the innermost axes, over strided outer axes, over every axis, and
+    // over axes that are not next to each other
+    migraphx::shape s{migraphx::shape::float_type, {2, 33, 5, 700}};
+    std::vector<float> data(s.elements());
+    std::mt19937 gen{0};
+    std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+    std::generate(data.begin(), data.end(), [&] { return dist(gen); });
+    std::vector<std::vector<int64_t>> axes_list = {
+        {3}, {2, 3}, {1}, {0}, {1, 2}, {0, 1, 2, 3}, {0, 2}, {1, 3}};
+    for(const std::string name : {"reduce_sum", "reduce_mean", "reduce_max"})
+    {
+        for(const auto& axes : axes_list)
+        {
+            migraphx::program p;
+            auto* mm = p.get_main_module();
+            auto l0  = mm->add_literal(migraphx::literal{s, data});
+            auto r   = mm->add_instruction(migraphx::make_op(name, {{"axes", axes}}), l0);
+            auto out = r->get_shape();
+            p.compile(migraphx::ref::target{});
+            auto result = p.eval({}).back();
+            std::vector<float> results_vector;
+            result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+
+            bool is_max = name == "reduce_max";
+            std::vector<double> gold(out.elements(),
+                                     is_max ? std::numeric_limits<double>::lowest() : 0.0);
+            migraphx::shape_for_each(s, [&](const auto& idx) {
+                auto out_idx = idx;
+                for(auto axis : axes)
+                    out_idx[axis] = 0;
+                auto& g = gold[out.index(out_idx)];
+                auto x  = data[s.index(idx)];
+                g       = is_max ? std::max<double>(g, x) : g + x;
+            });
+            if(name == "reduce_mean")
+            {
+                auto n = s.elements() / out.elements();
+                std::transform(
+                    gold.begin(), gold.end(), gold.begin(), [&](auto x) { return x / n; });
+            }
+            EXPECT(migraphx::verify_range(results_vector, gold));
+        }
+    }
+}
+
 TEST_CASE(relu_test)
 {
     migraphx::program p;
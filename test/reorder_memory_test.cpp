@@ -0,0 +1,135 @@
+#include <migraphx/reorder_memory.hpp>
+#include <migraphx/memory_coloring.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/program.hpp>
+#include <basic_ops.hpp>
+#include <test.hpp>
+
+void run_pass(migraphx::module& m)
+{
+    migraphx::run_passes(m, {migraphx::reorder_memory{"allocate"}});
+}
+
+struct allocate
+{
+    migraphx::shape s{};
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::pack(f(self.s, "shape"));
+    }
+
+    std::string name() const { return "allocate"; }
+    migraphx::shape compute_shape(const std::vector<migraphx::shape>& inputs) const
+    {
+        migraphx::check_shapes{inputs, *this}.has(0);
+        return s;
+    }
+    migraphx::argument compute(migraphx::context&,
+                               const migraphx::shape& output_shape,
+                               const std::vector<migraphx::argument>&) const
+    {
+        return {output_shape};
+    }
+};
+
+migraphx::instruction_ref add_alloc(migraphx::module& m, const migraphx::shape& s)
+{
+    return m.add_instruction(allocate{s});
+}
+
+std::size_t scratch_bytes(migraphx::module m)
+{
+    migraphx::run_passes(m, {migraphx::memory_coloring{"allocate"}});
+    return m.get_parameter_shape("scratch").bytes();
+}
+
+bool is_before(const migraphx::module& m, migraphx::instruction_ref x, migraphx::instruction_ref y)
+{
+    for(auto ins : migraphx::iterator_for(m))
+    {
+        if(ins == y)
+            return false;
+        if(ins == x)
+            return true;
+    }
+    return false;
+}
+
+TEST_CASE(reduce_branches)
+{
+    migraphx::module m;
+
+    auto x  = m.add_parameter("x", {migraphx::shape::float_type, {64}});
+    auto a1 = add_alloc(m, {migraphx::shape::float_type, {256}});
+    auto b1 = m.add_instruction(pass_op{}, a1, x);
+    auto a2 = add_alloc(m, {migraphx::shape::float_type, {256}});
+    auto b2 = m.add_instruction(pass_op{}, a2, x);
+    auto a3 = add_alloc(m, {migraphx::shape::float_type, {4}});
+    auto r1 = m.add_instruction(pass_op{}, a3, b1);
+    auto a4 = add_alloc(m, {migraphx::shape::float_type, {4}});
+    auto r2 = m.add_instruction(pass_op{}, a4, b2);
+    auto a5 = add_alloc(m, {migraphx::shape::float_type, {8}});
+    auto c  = m.add_instruction(pass_op{}, a5, r1, r2);
+    m.add_return({c});
+    auto before = scratch_bytes(m);
+    run_pass(m);
+    EXPECT(bool{m.validate() == m.end()});
+    EXPECT(scratch_bytes(m) < before);
+    // The first branch is reduced before the second one is computed
+    EXPECT(is_before(m, r1, b2));
+    EXPECT(is_before(m, a2, b2));
+    EXPECT(std::prev(m.end())->name() == "@return");
+}
+
+TEST_CASE(chain_unchanged)
+{
+    migraphx::module m;
+
+    auto x  = m.add_parameter("x", {migraphx::shape::float_type, {64}});
+    auto a1 = add_alloc(m, {migraphx::shape::float_type, {64}});
+    auto p1 = m.add_instruction(pass_op{}, a1, x);
+    auto a2 = add_alloc(m, {migraphx::shape::float_type, {64}});
+    auto p2 = m.add_instruction(pass_op{}, a2, p1);
+    auto a3 = add_alloc(m, {migraphx::shape::float_type, {64}});
+    auto p3 = m.add_instruction(pass_op{}, a3, p2);
+    m.add_return({p3});
+    auto m1 = m;
+    run_pass(m);
+    EXPECT(m1 == m);
+}
+
+TEST_CASE(submodule_dependency)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    auto x  = mm->add_parameter("x", {migraphx::shape::float_type, {64}});
+    auto a1 = add_alloc(*mm, {migraphx::shape::float_type, {256}});
+    auto b1 = mm->add_instruction(pass_op{}, a1, x);
+    auto a2 = add_alloc(*mm, {migraphx::shape::float_type, {256}});
+    auto b2 = mm->add_instruction(pass_op{}, a2, x);
+
+    // The submodule reads the first branch, which must stay live until the instruction using it
+    auto* sm = p.create_module("sub");
+    sm->add_return({sm->add_instruction(pass_op{}, b1)});
+    auto a3 = add_alloc(*mm, {migraphx::shape::float_type, {4}});
+    auto r1 = mm->add_instruction(mod_pass_op{}, {a3}, {sm});
+    auto a4 = add_alloc(*mm, {migraphx::shape::float_type, {4}});
+    auto r2 = mm->add_instruction(pass_op{}, a4, b2);
+    auto a5 = add_alloc(*mm, {migraphx::shape::float_type, {8}});
+    auto c  = mm->add_instruction(pass_op{}, a5, r1, r2);
+    mm->add_return({c});
+    run_pass(*mm);
+    EXPECT(bool{mm->validate() == mm->end()});
+    EXPECT(is_before(*mm, b1, r1));
+    EXPECT(is_before(*mm, r1, b2));
+    EXPECT(is_before(*mm, r1, c));
+    EXPECT(is_before(*mm, r2, c));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,149 @@
+#include <migraphx/request_batcher.hpp>
+#include <migraphx/ref/target.hpp>
+#include <migraphx/make_op.hpp>
+#include "test.hpp"
+
+migraphx::program create_program(std::size_t batch_size)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {batch_size, 3}};
+    auto x  = mm->add_parameter("x", s);
+    auto y  = mm->add_parameter("y", {migraphx::shape::float_type, {3}});
+    auto b  = mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), y);
+    auto xy = mm->add_instruction(migraphx::make_op("add"), x, b);
+    mm->add_return({xy, y});
+    return p;
+}
+
+migraphx::program_buckets create_buckets(std::vector<std::size_t> batch_sizes)
+{
+    migraphx::program_buckets buckets;
+    for(auto batch_size : batch_sizes)
+        buckets.insert(batch_size, create_program(batch_size));
+    buckets.compile(migraphx::ref::target{});
+    return buckets;
+}
+
+migraphx::parameter_map create_request(std::vector<float> x, float y)
+{
+    migraphx::parameter_map params;
+    params["x"] = migraphx::argument{{migraphx::shape::float_type, {x.size() / 3, 3}}};
+    params["y"] = migraphx::argument{{migraphx::shape::float_type, {3}}};
+    std::copy(x.begin(), x.end(), reinterpret_cast<float*>(params["x"].data()));
+    std::fill_n(reinterpret_cast<float*>(params["y"].data()), 3, y);
+    return params;
+}
+
+std::vector<float> to_vector(const migraphx::argument& arg)
+{
+    std::vector<float> result;
+    arg.visit([&](auto output) { result.assign(output.begin(), output.end()); });
+    return result;
+}
+
+TEST_CASE(batch_requests)
+{
+    migraphx::request_batcher_options options;
+    options.max_delay = std::chrono::seconds{10};
+    migraphx::request_batcher batcher{create_buckets({2, 4}), options};
+    auto r1 = batcher.submit(create_request({0, 1, 2}, 1));
+    auto r2 = batcher.submit(create_request({3, 4, 5, 6, 7, 8}, 1));
+    auto r3 = batcher.submit(create_request({9, 10, 11}, 1));
+    auto x1 = r1.get();
+    auto x2 = r2.get();
+    auto x3 = r3.get();
+    EXPECT(x1.size() == 2);
+    EXPECT(to_vector(x1[0]) == std::vector<float>{1, 2, 3});
+    EXPECT(to_vector(x2[0]) == std::vector<float>{4, 5, 6, 7, 8, 9});
+    EXPECT(to_vector(x3[0]) == std::vector<float>{10, 11, 12});
+    EXPECT(to_vector(x1[1]) == std::vector<float>{1, 1, 1});
+    EXPECT(to_vector(x3[1]) == std::vector<float>{1, 1, 1});
+
+    auto stats = batcher.get_stats();
+    EXPECT(stats.requests == 3);
+    EXPECT(stats.batches == 1);
+    EXPECT(stats.samples == 4);
+    EXPECT(stats.padded_samples == 4);
+    EXPECT(stats.max_latency >= stats.average_latency());
+}
+
+TEST_CASE(batch_unbatched_parameters)
+{
+    // A request with another value for a parameter that is not batched is evaluated separately,
+    // without waiting for the delay
+    migraphx::request_batcher_options options;
+    options.max_delay = std::chrono::seconds{10};
+    migraphx::request_batcher batcher{create_buckets({2, 4}), options};
+    auto r1 = batcher.submit(create_request({0, 1, 2}, 1));
+    auto r2 = batcher.submit(create_request({3, 4, 5}, 1));
+    auto r3 = batcher.submit(create_request({9, 10, 11, 0, 0, 0}, 3));
+    auto r4 = batcher.submit(create_request({6, 7, 8, 1, 1, 1}, 3));
+    auto x1 = r1.get();
+    auto x2 = r2.get();
+    auto x3 = r3.get();
+    auto x4 = r4.get();
+    EXPECT(to_vector(x1[0]) == std::vector<float>{1, 2, 3});
+    EXPECT(to_vector(x2[0]) == std::vector<float>{4, 5, 6});
+    EXPECT(to_vector(x3[0]) == std::vector<float>{12, 13, 14, 3, 3, 3});
+    EXPECT(to_vector(x4[0]) == std::vector<float>{9, 10, 11, 4, 4, 4});
+    EXPECT(to_vector(x2[1]) == std::vector<float>{1, 1, 1});
+    EXPECT(to_vector(x3[1]) == std::vector<float>{3, 3, 3});
+
+    auto stats = batcher.get_stats();
+    EXPECT(stats.requests == 4);
+    EXPECT(stats.batches == 2);
+    EXPECT(stats.samples == 6);
+    EXPECT(stats.padded_samples == 6);
+    EXPECT(stats.max_latency < 10000);
+}
+
+TEST_CASE(batch_delay)
+{
+    migraphx::request_batcher_options options;
+    options.max_delay = std::chrono::milliseconds{1};
+    migraphx::request_batcher batcher{create_buckets({2, 4}), options};
+    auto x = batcher.submit(create_request({0, 1, 2}, 1)).get();
+    EXPECT(to_vector(x[0]) == std::vector<float>{1, 2, 3});
+
+    auto stats = batcher.get_stats();
+    EXPECT(stats.batches == 1);
+    EXPECT(stats.samples == 1);
+    EXPECT(stats.padded_samples == 2);
+    EXPECT(stats.throughput() > 0);
+}
+
+TEST_CASE(max_batch_size)
+{
+    migraphx::request_batcher_options options;
+    options.max_batch_size = 2;
+    options.max_delay      = std::chrono::milliseconds{1};
+    std::vector<std::future<std::vector<migraphx::argument>>> results;
+    {
+        migraphx::request_batcher batcher{create_buckets({2, 4}), options};
+        for(std::size_t i = 0; i < 5; i++)
+            results.push_back(batcher.submit(create_request({0, 1, 2}, i)));
+        EXPECT(test::throws(
+            [&] { batcher.submit(create_request({0, 1, 2, 3, 4, 5, 6, 7, 8}, 0)); }));
+        EXPECT(test::throws([&] {
+            auto params = create_request({0, 1, 2}, 0);
+            params.erase("x");
+            batcher.submit(params);
+        }));
+    }
+    // Queued requests are evaluated before the batcher is destroyed
+    EXPECT(std::all_of(results.begin(), results.end(), [](auto&& r) {
+        return r.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+    }));
+    EXPECT(to_vector(results.back().get()[1]) == std::vector<float>{4, 4, 4});
+}
+
+TEST_CASE(invalid_options)
+{
+    migraphx::request_batcher_options options;
+    options.max_batch_size = 8;
+    EXPECT(test::throws([&] { migraphx::request_batcher{create_buckets({2, 4}), options}; }));
+    EXPECT(test::throws([&] { migraphx::request_batcher{migraphx::program_buckets{}}; }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
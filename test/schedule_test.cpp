@@ -158,6 +158,7 @@ bool check_conflicts(migraphx::module& m, migraphx::instruction_ref x, migraphx:
 struct scheduler
 {
     schedule_model_test model{};
+    migraphx::cost_model cost{};
 
     std::size_t get_stream(migraphx::instruction_ref ins) { return model.ins2stream->at(ins); }
 
@@ -170,7 +171,10 @@ struct scheduler
         return result;
     }
 
-    void run_pass(migraphx::module& m) { migraphx::run_passes(m, {migraphx::schedule{model}}); }
+    void run_pass(migraphx::module& m)
+    {
+        migraphx::run_passes(m, {migraphx::schedule{model, true, cost}});
+    }
 
     bool has_stream(migraphx::instruction_ref ins) { return model.ins2stream->count(ins) > 0; }
 
@@ -432,6 +436,50 @@ TEST_CASE(two_branches)
     t.check_conflicts(m, {c1, {i1}});
 }
 
+TEST_CASE(two_branches_cost)
+{
+    scheduler t{};
+    t.cost.bandwidth = 1.0e8;
+    migraphx::module m;
+
+    auto small  = m.add_literal(migraphx::generate_literal({migraphx::shape::float_type, {1024}}));
+    auto large  = m.add_literal(migraphx::generate_literal({migraphx::shape::float_type, {8192}}));
+    auto c1     = chain(m, 2, unary_op{}, small);
+    auto i1     = m.add_instruction(unary_op{}, large);
+    auto binary = m.add_instruction(nary_op{}, i1, c1.back());
+    t.run_pass(m);
+    // The single instruction on the large tensor takes longer than the chain on the small one
+    EXPECT(t.get_stream(i1) == 0);
+    for(auto ins : c1)
+        EXPECT(t.get_stream(ins) == 1);
+    EXPECT(t.get_stream(binary) == 0);
+    t.check_conflicts(m, {c1, {i1}});
+}
+
+TEST_CASE(cheap_branches_cost)
+{
+    scheduler t{};
+    t.cost.bandwidth = 1.0e9;
+    migraphx::module m;
+
+    auto small  = m.add_literal(migraphx::generate_literal({migraphx::shape::float_type, {1024}}));
+    auto large  = m.add_literal(migraphx::generate_literal({migraphx::shape::float_type, {8192}}));
+    auto c1     = chain(m, 2, unary_op{}, large);
+    auto i1     = m.add_instruction(unary_op{}, small);
+    auto i2     = m.add_instruction(unary_op{}, small);
+    auto binary = m.add_instruction(nary_op{}, i1, i2, c1.back());
+    t.run_pass(m);
+    // The single instructions take a few microseconds, which is above the threshold of the
+    // schedule model but less than the cost of a stream, so everything stays on one stream
+    EXPECT(t.cost.weight(i1) > 2);
+    EXPECT(not t.has_stream(i1));
+    EXPECT(not t.has_stream(i2));
+    for(auto ins : c1)
+        EXPECT(not t.has_stream(ins));
+    EXPECT(not t.has_stream(binary));
+    EXPECT(get_wait_for(binary).empty());
+}
+
 TEST_CASE(four_branches)
 {
     scheduler t{};
@@ -0,0 +1,182 @@
+#include <migraphx/sink_transpose.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/ref/target.hpp>
+
+#include <test.hpp>
+
+void run_pass(migraphx::module& m)
+{
+    migraphx::run_passes(m, {migraphx::sink_transpose{}, migraphx::dead_code_elimination{}});
+}
+
+static std::size_t count_transposes(const migraphx::module& m)
+{
+    return std::count_if(
+        m.begin(), m.end(), [](const auto& ins) { return ins.name() == "transpose"; });
+}
+
+static migraphx::argument run_ref(migraphx::program p, const migraphx::parameter_map& params)
+{
+    p.compile(migraphx::ref::target{});
+    return p.eval(params).back();
+}
+
+// Runs the program on the ref target before and after the pass with the same generated parameters
+static bool run_and_compare(migraphx::program& p)
+{
+    migraphx::parameter_map params;
+    for(auto&& x : p.get_parameter_shapes())
+        params[x.first] = migraphx::generate_argument(x.second);
+    auto expected = run_ref(p, params);
+    run_pass(*p.get_main_module());
+    auto result = run_ref(p, params);
+    return expected == result;
+}
+
+static const std::vector<int64_t> nhwc_to_nchw = {0, 3, 1, 2};
+static const std::vector<int64_t> nchw_to_nhwc = {0, 2, 3, 1};
+
+TEST_CASE(cancel_through_unary)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {1, 4, 5, 3}});
+    auto t1 =
+        mm->add_instruction(migraphx::make_op("transpose", {{"permutation", nhwc_to_nchw}}), x);
+    auto r = mm->add_instruction(migraphx::make_op("relu"), t1);
+    auto t2 =
+        mm->add_instruction(migraphx::make_op("transpose", {{"permutation", nchw_to_nhwc}}), r);
+    auto e = mm->add_instruction(migraphx::make_op("exp"), t2);
+    mm->add_return({e});
+    EXPECT(run_and_compare(p));
+    EXPECT(count_transposes(*mm) == 0);
+    EXPECT(mm->get_output_shapes().back().standard());
+}
+
+TEST_CASE(cancel_through_broadcast_add)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {1, 4, 5, 3}});
+    auto b   = mm->add_literal(migraphx::generate_literal({migraphx::shape::float_type, {3}}));
+    auto t1 =
+        mm->add_instruction(migraphx::make_op("transpose", {{"permutation", nhwc_to_nchw}}), x);
+    auto mb = mm->add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", {1, 3, 4, 5}}}), b);
+    auto add = mm->add_instruction(migraphx::make_op("add"), t1, mb);
+    auto t2 =
+        mm->add_instruction(migraphx::make_op("transpose", {{"permutation", nchw_to_nhwc}}), add);
+    auto r = mm->add_instruction(migraphx::make_op("relu"), t2);
+    mm->add_return({r});
+    EXPECT(run_and_compare(p));
+    // Only the transpose of the broadcasted bias remains, which does not copy any data
+    auto t = std::find_if(
+        mm->begin(), mm->end(), [](const auto& ins) { return ins.name() == "transpose"; });
+    EXPECT(count_transposes(*mm) == 1);
+    EXPECT(t->get_shape().broadcasted());
+}
+
+TEST_CASE(no_sink_non_transposed_input)
+{
+    migraphx::module m;
+    auto x  = m.add_parameter("x", {migraphx::shape::float_type, {1, 4, 5, 3}});
+    auto y  = m.add_parameter("y", {migraphx::shape::float_type, {1, 3, 4, 5}});
+    auto t1 = m.add_instruction(migraphx::make_op("transpose", {{"permutation", nhwc_to_nchw}}), x);
+    auto a  = m.add_instruction(migraphx::make_op("add"), t1, y);
+    auto r  = m.add_instruction(migraphx::make_op("relu"), a);
+    m.add_return({r});
+    auto m1 = m;
+    run_pass(m);
+    EXPECT(m1 == m);
+}
+
+TEST_CASE(no_sink_into_return)
+{
+    migraphx::module m;
+    auto x  = m.add_parameter("x", {migraphx::shape::float_type, {1, 4, 5, 3}});
+    auto t1 = m.add_instruction(migraphx::make_op("transpose", {{"permutation", nhwc_to_nchw}}), x);
+    auto r  = m.add_instruction(migraphx::make_op("relu"), t1);
+    m.add_return({r});
+    auto m1 = m;
+    run_pass(m);
+    EXPECT(m1 == m);
+}
+
+TEST_CASE(sink_reduce)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {2, 4, 5, 3}});
+    auto t1 =
+        mm->add_instruction(migraphx::make_op("transpose", {{"permutation", nhwc_to_nchw}}), x);
+    auto rd = mm->add_instruction(migraphx::make_op("reduce_mean", {{"axes", {2, -1}}}), t1);
+    auto r  = mm->add_instruction(migraphx::make_op("relu"), rd);
+    mm->add_return({r});
+    EXPECT(run_and_compare(p));
+    auto rins = std::find_if(
+        mm->begin(), mm->end(), [](const auto& ins) { return ins.name() == "reduce_mean"; });
+    EXPECT(rins->inputs().front()->name() == "@param");
+    EXPECT(rins->get_operator().to_value()["axes"].to_vector<int64_t>() ==
+           std::vector<int64_t>{1, 2});
+}
+
+TEST_CASE(sink_concat)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {1, 4, 5, 3}});
+    auto y   = mm->add_parameter("y", {migraphx::shape::float_type, {1, 4, 5, 2}});
+    auto tx =
+        mm->add_instruction(migraphx::make_op("transpose", {{"permutation", nhwc_to_nchw}}), x);
+    auto ty =
+        mm->add_instruction(migraphx::make_op("transpose", {{"permutation", nhwc_to_nchw}}), y);
+    auto c = mm->add_instruction(migraphx::make_op("concat", {{"axis", 1}}), tx, ty);
+    auto t2 =
+        mm->add_instruction(migraphx::make_op("transpose", {{"permutation", nchw_to_nhwc}}), c);
+    auto r = mm->add_instruction(migraphx::make_op("relu"), t2);
+    mm->add_return({r});
+    EXPECT(run_and_compare(p));
+    EXPECT(count_transposes(*mm) == 0);
+    auto cins = std::find_if(
+        mm->begin(), mm->end(), [](const auto& ins) { return ins.name() == "concat"; });
+    EXPECT(cins->get_operator().to_value()["axis"].to<int64_t>() == 3);
+}
+
+TEST_CASE(sink_slice)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {1, 4, 5, 6}});
+    auto t1 =
+        mm->add_instruction(migraphx::make_op("transpose", {{"permutation", nhwc_to_nchw}}), x);
+    auto s = mm->add_instruction(
+        migraphx::make_op("slice", {{"axes", {1}}, {"starts", {2}}, {"ends", {5}}}), t1);
+    auto t2 =
+        mm->add_instruction(migraphx::make_op("transpose", {{"permutation", nchw_to_nhwc}}), s);
+    auto r = mm->add_instruction(migraphx::make_op("relu"), t2);
+    mm->add_return({r});
+    EXPECT(run_and_compare(p));
+    EXPECT(count_transposes(*mm) == 0);
+}
+
+TEST_CASE(no_sink_multiple_outputs)
+{
+    migraphx::module m;
+    auto x  = m.add_parameter("x", {migraphx::shape::float_type, {1, 4, 5, 3}});
+    auto t1 = m.add_instruction(migraphx::make_op("transpose", {{"permutation", nhwc_to_nchw}}), x);
+    auto r  = m.add_instruction(migraphx::make_op("relu"), t1);
+    auto e  = m.add_instruction(migraphx::make_op("exp"), r);
+    auto n  = m.add_instruction(migraphx::make_op("neg"), t1);
+    m.add_return({e, n});
+    auto m1 = m;
+    run_pass(m);
+    EXPECT(m1 == m);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,123 @@
+#include <migraphx/strided_index.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <migraphx/tensor_view.hpp>
+#include <migraphx/par_dfor.hpp>
+#include <migraphx/dfor.hpp>
+#include <mutex>
+#include <numeric>
+#include "test.hpp"
+
+std::vector<migraphx::shape> test_shapes()
+{
+    return {{migraphx::shape::float_type, {2, 3, 4}},
+            {migraphx::shape::float_type, {2, 3, 4}, {1, 2, 6}},
+            {migraphx::shape::float_type, {2, 3, 4}, {0, 1, 0}},
+            {migraphx::shape::float_type, {2, 1, 3, 4}, {24, 12, 4, 1}},
+            {migraphx::shape::float_type, {2, 3, 4}, {20, 5, 1}},
+            {migraphx::shape::float_type, {1}, {0}},
+            {migraphx::shape::float_type, {2, 2, 2, 2, 2, 2, 2, 2}, {1, 2, 4, 8, 16, 32, 64, 128}}};
+}
+
+TEST_CASE(increment)
+{
+    for(auto&& s : test_shapes())
+    {
+        migraphx::strided_index si{s};
+        for(std::size_t i = 0; i < s.elements(); i++)
+        {
+            EXPECT(si.element() == i);
+            EXPECT(si.offset() == s.index(i));
+            ++si;
+        }
+        EXPECT(si.element() == s.elements());
+    }
+}
+
+TEST_CASE(decrement)
+{
+    for(auto&& s : test_shapes())
+    {
+        migraphx::strided_index si{s, s.elements()};
+        for(std::size_t i = s.elements(); i > 0; i--)
+        {
+            --si;
+            EXPECT(si.element() == i - 1);
+            EXPECT(si.offset() == s.index(i - 1));
+        }
+    }
+}
+
+TEST_CASE(advance)
+{
+    for(auto&& s : test_shapes())
+    {
+        migraphx::strided_index si{s};
+        for(std::size_t i = 0; i + 5 < s.elements(); i += 5)
+        {
+            EXPECT(si.offset() == s.index(i));
+            si += 5;
+        }
+        if(si.element() < 3)
+            continue;
+        si -= 3;
+        EXPECT(si.offset() == s.index(si.element()));
+    }
+}
+
+TEST_CASE(empty_shape)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 0, 3}};
+    migraphx::strided_index si{s};
+    EXPECT(si.element() == 0);
+    EXPECT(si.offset() == 0);
+}
+
+TEST_CASE(tensor_view_transposed)
+{
+    migraphx::shape s{migraphx::shape::float_type, {3, 2}, {1, 3}};
+    std::vector<float> data = {0, 1, 2, 3, 4, 5};
+    auto view               = migraphx::make_view(s, data.data());
+    std::vector<float> result(view.begin(), view.end());
+    EXPECT(result == std::vector<float>{0, 3, 1, 4, 2, 5});
+    EXPECT(view.end() - view.begin() == 6);
+    EXPECT(view.begin()[3] == 4);
+    EXPECT(*(view.end() - 1) == 5);
+    EXPECT(std::vector<float>(view.end() - 2, view.end()) == std::vector<float>{2, 5});
+}
+
+TEST_CASE(tensor_view_sort)
+{
+    migraphx::shape s{migraphx::shape::float_type, {3, 2}, {1, 3}};
+    std::vector<float> data = {5, 2, 4, 0, 3, 1};
+    auto view               = migraphx::make_view(s, data.data());
+    std::sort(view.begin(), view.end());
+    EXPECT(view.to_vector() == std::vector<float>{0, 1, 2, 3, 4, 5});
+    EXPECT(data == std::vector<float>{0, 2, 4, 1, 3, 5});
+}
+
+TEST_CASE(shape_for_each_order)
+{
+    for(auto&& s : test_shapes())
+    {
+        migraphx::shape ss{s.type(), s.lens()};
+        std::size_t i = 0;
+        migraphx::shape_for_each(s, [&](const auto& idx) {
+            EXPECT(idx == ss.multi(i));
+            i++;
+        });
+        EXPECT(i == s.elements());
+    }
+}
+
+TEST_CASE(par_dfor_all)
+{
+    std::vector<std::size_t> visited(4 * 5 * 6);
+    std::mutex m;
+    migraphx::par_dfor(4, 5, 6)([&](std::size_t i, std::size_t j, std::size_t k) {
+        std::lock_guard<std::mutex> lock(m);
+        visited[i * 30 + j * 6 + k]++;
+    });
+    EXPECT(std::all_of(visited.begin(), visited.end(), [](auto x) { return x == 1; }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
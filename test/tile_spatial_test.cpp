@@ -0,0 +1,162 @@
+#include <migraphx/tile_spatial.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/op/pooling.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/ref/target.hpp>
+
+#include <test.hpp>
+
+void run_pass(migraphx::module& m, std::size_t tile_bytes = 4096)
+{
+    migraphx::run_passes(
+        m, {migraphx::tile_spatial{tile_bytes, 4}, migraphx::dead_code_elimination{}});
+}
+
+static std::size_t count(const migraphx::module& m, const std::string& name)
+{
+    return std::count_if(m.begin(), m.end(), [&](const auto& ins) { return ins.name() == name; });
+}
+
+static migraphx::argument run_ref(migraphx::program p, const migraphx::parameter_map& params)
+{
+    p.compile(migraphx::ref::target{});
+    return p.eval(params).back();
+}
+
+// Runs the program on the ref target before and after the pass with the same generated parameters
+static bool run_and_compare(migraphx::program& p, std::size_t tile_bytes = 4096)
+{
+    migraphx::parameter_map params;
+    for(auto&& x : p.get_parameter_shapes())
+        params[x.first] = migraphx::generate_argument(x.second);
+    auto expected = run_ref(p, params);
+    run_pass(*p.get_main_module(), tile_bytes);
+    auto result = run_ref(p, params);
+    return expected == result;
+}
+
+static migraphx::instruction_ref add_conv(migraphx::module& m,
+                                          migraphx::instruction_ref x,
+                                          std::size_t channels,
+                                          std::size_t k,
+                                          const migraphx::value& v = {})
+{
+    auto c = x->get_shape().lens()[1];
+    auto w = m.add_literal(
+        migraphx::generate_literal({migraphx::shape::float_type, {channels, c, k, k}}, k));
+    return m.add_instruction(migraphx::make_op("convolution", v), x, w);
+}
+
+static migraphx::instruction_ref add_bias_relu(migraphx::module& m, migraphx::instruction_ref x)
+{
+    auto lens = x->get_shape().lens();
+    auto b    = m.add_literal(
+        migraphx::generate_literal({migraphx::shape::float_type, {lens[1]}}, lens[1]));
+    auto bb = m.add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", lens}}), b);
+    auto add = m.add_instruction(migraphx::make_op("add"), x, bb);
+    return m.add_instruction(migraphx::make_op("relu"), add);
+}
+
+TEST_CASE(conv_chain)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {1, 3, 32, 32}});
+    auto c1  = add_conv(*mm, x, 4, 3, {{"padding", {1, 1}}});
+    auto r1  = add_bias_relu(*mm, c1);
+    auto c2  = add_conv(*mm, r1, 4, 3, {{"padding", {1, 1}}});
+    auto r2  = add_bias_relu(*mm, c2);
+    auto pool =
+        mm->add_instruction(migraphx::make_op("pooling",
+                                              {{"mode", migraphx::op::pooling_mode::max},
+                                               {"lengths", {2, 2}},
+                                               {"stride", {2, 2}}}),
+                            r2);
+    mm->add_return({pool});
+    EXPECT(run_and_compare(p));
+    EXPECT(count(*mm, "concat") == 1);
+    EXPECT(count(*mm, "convolution") > 2);
+    EXPECT(count(*mm, "pooling") == count(*mm, "convolution") / 2);
+}
+
+TEST_CASE(strided_dilated_chain)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {2, 2, 37, 20}});
+    auto c1  = add_conv(*mm, x, 3, 3, {{"padding", {1, 1}}, {"stride", {2, 2}}});
+    auto r1  = add_bias_relu(*mm, c1);
+    auto c2  = add_conv(*mm, r1, 3, 3, {{"padding", {2, 2}}, {"dilation", {2, 2}}});
+    auto c3  = add_conv(*mm, c2, 2, 5, {{"padding", {0, 2, 1, 2}}});
+    mm->add_return({c3});
+    EXPECT(run_and_compare(p));
+    EXPECT(count(*mm, "concat") == 1);
+    EXPECT(count(*mm, "convolution") > 3);
+}
+
+TEST_CASE(residual_average_pooling)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {1, 4, 30, 16}});
+    auto y   = mm->add_parameter("y", {migraphx::shape::float_type, {1, 4, 30, 16}});
+    auto c1  = add_conv(*mm, x, 4, 3, {{"padding", {1, 1}}});
+    auto add = mm->add_instruction(migraphx::make_op("add"), c1, y);
+    auto pool =
+        mm->add_instruction(migraphx::make_op("pooling",
+                                              {{"mode", migraphx::op::pooling_mode::average},
+                                               {"lengths", {3, 3}},
+                                               {"padding", {1, 1}}}),
+                            add);
+    mm->add_return({pool});
+    EXPECT(run_and_compare(p));
+    EXPECT(count(*mm, "concat") == 1);
+    EXPECT(count(*mm, "pooling") > 1);
+}
+
+TEST_CASE(small_chain)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {1, 3, 32, 32}});
+    auto c1  = add_conv(*mm, x, 4, 3, {{"padding", {1, 1}}});
+    auto c2  = add_conv(*mm, c1, 4, 3, {{"padding", {1, 1}}});
+    mm->add_return({c2});
+    EXPECT(run_and_compare(p, 1024 * 1024));
+    EXPECT(count(*mm, "concat") == 0);
+    EXPECT(count(*mm, "convolution") == 2);
+}
+
+TEST_CASE(single_conv)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {1, 3, 32, 32}});
+    auto c1  = add_conv(*mm, x, 4, 3, {{"padding", {1, 1}}});
+    auto r1  = add_bias_relu(*mm, c1);
+    mm->add_return({r1});
+    EXPECT(run_and_compare(p));
+    EXPECT(count(*mm, "concat") == 0);
+    EXPECT(count(*mm, "convolution") == 1);
+}
+
+TEST_CASE(shared_intermediate)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {1, 3, 32, 32}});
+    auto c1  = add_conv(*mm, x, 4, 3, {{"padding", {1, 1}}});
+    auto c2  = add_conv(*mm, c1, 4, 3, {{"padding", {1, 1}}});
+    mm->add_return({c1, c2});
+    EXPECT(run_and_compare(p));
+    EXPECT(count(*mm, "concat") == 0);
+    EXPECT(count(*mm, "convolution") == 2);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
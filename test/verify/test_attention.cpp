@@ -0,0 +1,62 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+migraphx::instruction_ref add_attention(migraphx::module& m,
+                                        std::vector<size_t> dims,
+                                        std::size_t seq_len,
+                                        const std::string& scale_op,
+                                        bool mask)
+{
+    auto kdims = dims;
+    auto vdims = dims;
+    auto sdims = dims;
+
+    kdims[kdims.size() - 2] = seq_len;
+    vdims[vdims.size() - 2] = seq_len;
+    sdims.back()            = seq_len;
+
+    auto q = m.add_parameter("q", migraphx::shape{migraphx::shape::float_type, dims});
+    auto k = m.add_parameter("k", migraphx::shape{migraphx::shape::float_type, kdims});
+    auto v = m.add_parameter("v", migraphx::shape{migraphx::shape::float_type, vdims});
+    auto kt =
+        m.add_instruction(migraphx::make_op("transpose", {{"permutation", {0, 1, 3, 2}}}), k);
+    auto scores = m.add_instruction(migraphx::make_op("dot"), q, kt);
+    auto scale  = m.add_literal(scale_op == "div" ? 8.0f : 0.125f);
+    auto scale_mbcast =
+        m.add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", sdims}}), scale);
+    auto x = m.add_instruction(migraphx::make_op(scale_op), scores, scale_mbcast);
+    if(mask)
+    {
+        auto m0 = m.add_parameter(
+            "mask", migraphx::shape{migraphx::shape::float_type, {sdims[0], 1, 1, seq_len}});
+        auto mask_mbcast =
+            m.add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", sdims}}), m0);
+        x = m.add_instruction(migraphx::make_op("add"), mask_mbcast, x);
+    }
+    auto softmax = m.add_instruction(migraphx::make_op("softmax", {{"axis", 3}}), x);
+    return m.add_instruction(migraphx::make_op("dot"), softmax, v);
+}
+
+struct test_attention : verify_program<test_attention>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        add_attention(*mm, {2, 4, 70, 16}, 130, "mul", false);
+        return p;
+    }
+};
+
+struct test_attention_mask : verify_program<test_attention_mask>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        add_attention(*mm, {2, 4, 70, 16}, 130, "div", true);
+        return p;
+    }
+};
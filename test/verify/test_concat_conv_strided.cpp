@@ -0,0 +1,32 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/op/pooling.hpp>
+
+struct test_concat_conv_strided : verify_program<test_concat_conv_strided>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        int axis = 1;
+        auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {2, 4, 6, 6}});
+        auto w0  = mm->add_literal(
+            migraphx::generate_literal({migraphx::shape::float_type, {3, 4, 3, 3}}, 1));
+        auto w1 = mm->add_literal(
+            migraphx::generate_literal({migraphx::shape::float_type, {5, 4, 1, 1}}, 2));
+        auto c0 =
+            mm->add_instruction(migraphx::make_op("convolution", {{"padding", {1, 1}}}), x, w0);
+        auto c1 = mm->add_instruction(migraphx::make_op("convolution"), x, w1);
+        auto pool =
+            mm->add_instruction(migraphx::make_op("pooling",
+                                                  {{"mode", migraphx::op::pooling_mode::max},
+                                                   {"padding", {1, 1}},
+                                                   {"lengths", {3, 3}}}),
+                                x);
+        auto cat = mm->add_instruction(migraphx::make_op("concat", {{"axis", axis}}), c0, c1, pool);
+        mm->add_instruction(migraphx::make_op("relu"), cat);
+        return p;
+    }
+};
@@ -0,0 +1,67 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+#include <migraphx/instruction.hpp>
+
+migraphx::instruction_ref add_conv_bias_relu(migraphx::module& m, migraphx::instruction_ref x)
+{
+    auto w =
+        m.add_literal(migraphx::generate_literal({migraphx::shape::float_type, {8, 8, 3, 3}}, 1));
+    auto b    = m.add_literal(migraphx::generate_literal({migraphx::shape::float_type, {8}}, 2));
+    auto conv = m.add_instruction(migraphx::make_op("convolution", {{"padding", {1, 1}}}), x, w);
+    auto bias = m.add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", conv->get_shape().lens()}}), b);
+    auto add = m.add_instruction(migraphx::make_op("add"), conv, bias);
+    return m.add_instruction(migraphx::make_op("relu"), add);
+}
+
+struct test_conv_bias_relu_add : verify_program<test_conv_bias_relu_add>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm  = p.get_main_module();
+        auto x    = mm->add_parameter("x", {migraphx::shape::float_type, {2, 8, 7, 7}});
+        auto y    = mm->add_parameter("y", {migraphx::shape::float_type, {2, 8, 7, 7}});
+        auto skip = mm->add_instruction(migraphx::make_op("tanh"), y);
+        auto relu = add_conv_bias_relu(*mm, x);
+        mm->add_instruction(migraphx::make_op("add"), skip, relu);
+        return p;
+    }
+};
+
+struct test_conv_bias_relu_add_param : verify_program<test_conv_bias_relu_add_param>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm  = p.get_main_module();
+        auto x    = mm->add_parameter("x", {migraphx::shape::float_type, {2, 8, 7, 7}});
+        auto y    = mm->add_parameter("y", {migraphx::shape::float_type, {2, 8, 7, 7}});
+        auto relu = add_conv_bias_relu(*mm, x);
+        auto add  = mm->add_instruction(migraphx::make_op("add"), relu, y);
+        mm->add_instruction(migraphx::make_op("add"), add, y);
+        return p;
+    }
+};
+
+// Only the first residual is accumulated as a sum, so the second one is read as a binary post op
+struct test_conv_bias_relu_add_add : verify_program<test_conv_bias_relu_add_add>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm   = p.get_main_module();
+        auto x     = mm->add_parameter("x", {migraphx::shape::float_type, {2, 8, 7, 7}});
+        auto y     = mm->add_parameter("y", {migraphx::shape::float_type, {2, 8, 7, 7}});
+        auto z     = mm->add_parameter("z", {migraphx::shape::float_type, {2, 8, 7, 7}});
+        auto skip1 = mm->add_instruction(migraphx::make_op("tanh"), y);
+        auto skip2 = mm->add_instruction(migraphx::make_op("sigmoid"), z);
+        auto relu  = add_conv_bias_relu(*mm, x);
+        auto add   = mm->add_instruction(migraphx::make_op("add"), relu, skip1);
+        mm->add_instruction(migraphx::make_op("add"), add, skip2);
+        return p;
+    }
+};
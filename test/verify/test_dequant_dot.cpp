@@ -0,0 +1,40 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/op/dequant_dot.hpp>
+
+// The weights cover every byte, so the 4-bit weights have both signs in both nibbles
+template <std::size_t Bits, std::size_t GroupSize, std::size_t M, std::size_t K, std::size_t N>
+struct test_dequant_dot : verify_program<test_dequant_dot<Bits, GroupSize, M, K, N>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::op::dequant_dot op{Bits, GroupSize};
+        auto kp = migraphx::op::dequant_dot::packed_size(K, Bits);
+        migraphx::shape ws{Bits == 8 ? migraphx::shape::int8_type : migraphx::shape::uint8_type,
+                           {N, kp}};
+        std::vector<int> weights(ws.elements());
+        for(std::size_t i = 0; i < weights.size(); i++)
+            weights[i] = static_cast<int>((i * 37 + 11) % 256) - (Bits == 8 ? 128 : 0);
+        auto a = mm->add_parameter("a", {migraphx::shape::float_type, {M, K}});
+        auto b = mm->add_literal(migraphx::literal{ws, weights});
+        auto scales = mm->add_literal(
+            migraphx::generate_literal({migraphx::shape::float_type, {N, op.groups(K)}}, 1));
+        mm->add_instruction(op, a, b, scales);
+        return p;
+    }
+};
+
+// int8 gemv with a scale for each column
+template struct test_dequant_dot<8, 0, 1, 64, 19>;
+// int8 with the rows and the columns not a multiple of the blocks, and a partial last group
+template struct test_dequant_dot<8, 16, 19, 70, 21>;
+// int4 with a scale for each column
+template struct test_dequant_dot<4, 0, 11, 64, 17>;
+// int4 with groups
+template struct test_dequant_dot<4, 16, 19, 64, 23>;
+// int4 with an odd k, so the last byte of each column holds a single weight
+template struct test_dequant_dot<4, 8, 5, 37, 9>;
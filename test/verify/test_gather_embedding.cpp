@@ -0,0 +1,22 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+struct test_gather_embedding : verify_program<test_gather_embedding>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {1000, 64}};
+        migraphx::shape s_indices{migraphx::shape::int64_type, {4, 16}};
+        std::vector<int64_t> indices(s_indices.elements());
+        for(std::size_t i = 0; i < indices.size(); i++)
+            indices[i] = (i * 613) % 1000;
+        auto table = mm->add_parameter("table", s);
+        auto ind   = mm->add_literal(migraphx::literal{s_indices, indices});
+        mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), table, ind);
+        return p;
+    }
+};
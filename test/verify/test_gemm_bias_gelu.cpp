@@ -0,0 +1,38 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+struct test_gemm_bias_gelu : verify_program<test_gemm_bias_gelu>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        std::vector<size_t> out_lens{6, 16};
+        auto a = mm->add_parameter("a", {migraphx::shape::float_type, {6, 32}});
+        auto b = mm->add_literal(
+            migraphx::generate_literal({migraphx::shape::float_type, {32, 16}}, 1));
+        auto bias =
+            mm->add_literal(migraphx::generate_literal({migraphx::shape::float_type, {16}}, 2));
+        auto half        = mm->add_literal(0.5f);
+        auto one         = mm->add_literal(1.0f);
+        auto sqrt2       = mm->add_literal(static_cast<float>(M_SQRT2));
+        auto dot         = mm->add_instruction(migraphx::make_op("dot"), a, b);
+        auto bias_mbcast = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", out_lens}}), bias);
+        auto x           = mm->add_instruction(migraphx::make_op("add"), dot, bias_mbcast);
+        auto half_mbcast = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", out_lens}}), half);
+        auto mul_half     = mm->add_instruction(migraphx::make_op("mul"), x, half_mbcast);
+        auto sqrt2_mbcast = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", out_lens}}), sqrt2);
+        auto div        = mm->add_instruction(migraphx::make_op("div"), x, sqrt2_mbcast);
+        auto erf        = mm->add_instruction(migraphx::make_op("erf"), div);
+        auto one_mbcast = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", out_lens}}), one);
+        auto add_one = mm->add_instruction(migraphx::make_op("add"), erf, one_mbcast);
+        mm->add_instruction(migraphx::make_op("mul"), mul_half, add_one);
+        return p;
+    }
+};
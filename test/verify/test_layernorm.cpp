@@ -6,14 +6,16 @@
 
 #include <migraphx/op/reduce_mean.hpp>
 
-migraphx::instruction_ref
-add_layernorm(migraphx::module& m, migraphx::instruction_ref x, std::vector<size_t> dims)
+migraphx::instruction_ref add_layernorm(migraphx::module& m,
+                                        migraphx::instruction_ref x,
+                                        std::vector<size_t> dims,
+                                        float eps = 1e-12f)
 {
     auto scale =
         m.add_parameter("scale", migraphx::shape{migraphx::shape::float_type, {dims.back()}});
     auto bias =
         m.add_parameter("bias", migraphx::shape{migraphx::shape::float_type, {dims.back()}});
-    auto epsilon  = m.add_literal(1e-12f);
+    auto epsilon  = m.add_literal(eps);
     auto exponent = m.add_literal(2.0f);
 
     auto mean = m.add_instruction(migraphx::op::reduce_mean({2}), x);
@@ -98,3 +100,37 @@ struct test_layernorm_triadd_large : verify_program<test_layernorm_triadd_large>
         return p;
     }
 };
+
+struct test_layernorm_residual : verify_program<test_layernorm_residual>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm                 = p.get_main_module();
+        std::vector<size_t> dims = {1, 16, 96};
+        auto x   = mm->add_parameter("x", migraphx::shape{migraphx::shape::float_type, dims});
+        auto y   = mm->add_parameter("y", migraphx::shape{migraphx::shape::float_type, dims});
+        auto add = mm->add_instruction(migraphx::make_op("add"), x, y);
+        add_layernorm(*mm, add, dims, 1e-5f);
+        return p;
+    }
+};
+
+struct test_layernorm_residual_transposed : verify_program<test_layernorm_residual_transposed>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm                 = p.get_main_module();
+        std::vector<size_t> dims = {1, 16, 96};
+        migraphx::shape s{migraphx::shape::float_type, {1, 96, 16}};
+        auto x = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {0, 2, 1}}}),
+                                     mm->add_parameter("x", s));
+        auto y = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {0, 2, 1}}}),
+                                     mm->add_parameter("y", s));
+        // The add has the packed but transposed shape of its inputs
+        auto add = mm->add_instruction(migraphx::make_op("add"), x, y);
+        add_layernorm(*mm, add, dims, 1e-5f);
+        return p;
+    }
+};
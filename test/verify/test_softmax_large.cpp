@@ -0,0 +1,43 @@
+
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/op/logsoftmax.hpp>
+#include <migraphx/op/softmax.hpp>
+
+// Logits over a vocabulary, where the axis is long and innermost
+template <class Op>
+struct test_softmax_vocab : verify_program<test_softmax_vocab<Op>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {4, 32000}};
+        auto param = mm->add_parameter("x", s);
+        mm->add_instruction(migraphx::make_op(Op{}.name(), {{"axis", 1}}), param);
+        return p;
+    }
+};
+
+template struct test_softmax_vocab<migraphx::op::softmax>;
+template struct test_softmax_vocab<migraphx::op::logsoftmax>;
+
+// Attention scores normalized over a strided axis
+template <class Op>
+struct test_softmax_scores : verify_program<test_softmax_scores<Op>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {2, 12, 128, 128}};
+        auto param = mm->add_parameter("x", s);
+        mm->add_instruction(migraphx::make_op(Op{}.name(), {{"axis", 2}}), param);
+        return p;
+    }
+};
+
+template struct test_softmax_scores<migraphx::op::softmax>;
+template struct test_softmax_scores<migraphx::op::logsoftmax>;
@@ -3,6 +3,7 @@
 #include <migraphx/shape.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/onnx.hpp>
+#include <migraphx/program_buckets.hpp>
 #include <migraphx/tf.hpp>
 #include <migraphx/instruction_ref.hpp>
 #include <migraphx/register_target.hpp>
@@ -16,6 +17,7 @@
 #include <migraphx/convert_to_json.hpp>
 #include <algorithm>
 #include <cstdarg>
+#include <future>
 
 namespace migraphx {
 
@@ -207,6 +209,117 @@ bool equal(const T& x, const T& y)
 
 std::vector<argument> run(program& p, const parameter_map& params) { return p.eval(params); }
 
+std::vector<argument> run(program_buckets& p, const parameter_map& params)
+{
+    return p.eval(params);
+}
+
+struct run_options
+{
+    std::unordered_map<std::string, argument> outputs = {};
+    bool copy_outputs                                 = true;
+};
+
+void bind_output(run_options& options, const char* name, const argument& arg)
+{
+    options.outputs[name] = arg;
+}
+
+void set_copy_outputs(run_options& options, bool value) { options.copy_outputs = value; }
+
+static std::size_t get_output_index(const program& p, const std::string& name)
+{
+    auto prefix = p.get_main_module()->name() + ":#output_";
+    auto n      = p.get_output_shapes().size();
+    for(std::size_t i = 0; i < n; i++)
+    {
+        if(name == prefix + std::to_string(i))
+            return i;
+    }
+    MIGRAPHX_THROW(migraphx_status_bad_param, "Unknown output: " + name);
+}
+
+// The bound outputs are passed as parameters when the target writes its outputs to parameters,
+// otherwise the results are copied into them after the run
+std::vector<argument> run(program& p, parameter_map params, const run_options& options)
+{
+    auto param_shapes  = p.get_parameter_shapes();
+    auto output_shapes = p.get_output_shapes();
+    std::vector<std::pair<std::size_t, argument>> copies;
+    for(auto&& out : options.outputs)
+    {
+        auto s = out.second.get_shape();
+        if(param_shapes.count(out.first) > 0)
+        {
+            if(param_shapes.at(out.first) != s)
+                MIGRAPHX_THROW(migraphx_status_bad_param, "Wrong shape for output: " + out.first);
+            params[out.first] = out.second;
+            continue;
+        }
+        auto i = get_output_index(p, out.first);
+        if(output_shapes[i] != s)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Wrong shape for output: " + out.first);
+        if(not options.copy_outputs)
+            MIGRAPHX_THROW(migraphx_status_bad_param,
+                           "Output is not written in place and copies are disabled: " + out.first);
+        copies.emplace_back(i, out.second);
+    }
+    auto results = p.eval(params);
+    for(auto&& c : copies)
+    {
+        visit_all(c.second, results[c.first])([&](auto output, auto input) {
+            std::copy(input.begin(), input.end(), output.begin());
+        });
+        results[c.first] = c.second;
+    }
+    return results;
+}
+
+struct run_future
+{
+    std::shared_future<std::vector<argument>> result;
+
+    bool ready() const
+    {
+        return result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+    void wait() const { result.wait(); }
+    std::vector<argument> get() const { return result.get(); }
+};
+
+// The program must not be destroyed or run again until the run has finished. The callback is
+// called from the thread running the program, before the future is ready.
+run_future run_async(program& p,
+                     parameter_map params,
+                     const run_options& options,
+                     migraphx_run_callback callback,
+                     void* data)
+{
+    auto* pp = &p;
+    return {std::async(std::launch::async, [=] {
+        std::vector<argument> results;
+        std::exception_ptr error;
+        auto status = try_(
+            [&] {
+                try
+                {
+                    results = run(*pp, params, options);
+                }
+                catch(...)
+                {
+                    error = std::current_exception();
+                    throw;
+                }
+            },
+            false);
+        if(callback != nullptr)
+            callback(status, data);
+        if(error)
+            std::rethrow_exception(error);
+        return results;
+    })};
+}
+
 std::vector<shape> get_output_shapes(program& p) { return p.get_output_shapes(); }
 
 void print_program(const program& p) { std::cout << p << std::endl; }
@@ -43,6 +43,9 @@ typedef enum
 } migraphx_shape_datatype_t;
 #undef MIGRAPHX_SHAPE_GENERATE_ENUM_TYPES
 
+/// Called with the status of an asynchronous run when the run has finished
+typedef void (*migraphx_run_callback)(migraphx_status status, void* data);
+
 <% generate_c_header() %>
 
 #ifdef __cplusplus
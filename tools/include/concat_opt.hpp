@@ -26,15 +26,29 @@ struct concat_optimization
     std::string allocate() const;
     /// Return the target-independent concat operator
     op::concat get_concat(const operation& op) const;
+    /// Whether the operators can write to a strided slice of the allocation, which is needed to
+    /// concat along an axis that has a dimension greater than one before it
+    bool supports_strided() const;
 };
 
 #else
 
+namespace detail {
+
+template <class T>
+bool concat_supports_strided(const T&)
+{
+    return false;
+}
+
+} // namespace detail
+
 <%
 interface('concat_optimization',
     virtual('name', returns='std::string', const=True),
     virtual('allocate', returns='std::string', const=True),
-    virtual('get_concat', returns='op::concat', op='const operation&', const=True)
+    virtual('get_concat', returns='op::concat', op='const operation&', const=True),
+    virtual('supports_strided', returns='bool', const=True, default='migraphx::detail::concat_supports_strided')
 )
 %>
 